@@ -0,0 +1,150 @@
+#include "asynchronousSpikeRecorder.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+constexpr size_t AsynchronousSpikeRecorder::NUMBER_OF_RECORDS_PER_POP;
+constexpr unsigned int AsynchronousSpikeRecorder::IDLE_TIME;
+
+AsynchronousSpikeRecorder::AsynchronousSpikeRecorder(unique_ptr<SpikeRecorder> recorder, size_t capacity)
+:recorder(move(recorder))
+,channel(capacity)
+,statistics({0, 0, 0, 0})
+,numberOfFlushRequests(0)
+,numberOfFlushesDone(0)
+,isStopping(false)
+,hasFailed(false)
+,isErrorThrown(false)
+,writer(&AsynchronousSpikeRecorder::write, this)
+{}
+
+AsynchronousSpikeRecorder::~AsynchronousSpikeRecorder()
+{
+	isStopping.store(true, memory_order_release);
+	writer.join();
+	if(hasFailed.load(memory_order_acquire) and not isErrorThrown)	//a destructor mustn't throw, but the spikes are lost
+	{
+		try
+		{
+			rethrow_exception(error);
+		}
+		catch(const exception& exception)
+		{
+			cerr << "Error: " << exception.what() << endl;
+		}
+		catch(...)
+		{
+			cerr << "Error: the spikes couldn't be recorded" << endl;
+		}
+	}
+}
+
+void AsynchronousSpikeRecorder::record(unsigned int time, const unsigned int* firstNeuronId, const unsigned int* lastNeuronId)
+{
+	checkWriter();
+	size_t occupancy(0);
+	const unsigned int* neuronId(firstNeuronId + channel.push(time, firstNeuronId, lastNeuronId, occupancy));
+	if(neuronId != lastNeuronId)	//the channel is full, the simulation has to wait for the writer
+	{
+		const chrono::steady_clock::time_point start(chrono::steady_clock::now());
+		statistics.maximalOccupancy = channel.getCapacity();
+		while(neuronId != lastNeuronId)
+		{
+			this_thread::yield();
+			checkWriter();
+			neuronId += channel.push(time, neuronId, lastNeuronId, occupancy);
+		}
+		statistics.numberOfStalls++;
+		statistics.stallTime += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	}
+	statistics.maximalOccupancy = max(statistics.maximalOccupancy, occupancy);
+	statistics.numberOfSpikes += lastNeuronId - firstNeuronId;
+}
+
+void AsynchronousSpikeRecorder::flush()
+{
+	const unsigned long request(numberOfFlushRequests.fetch_add(1, memory_order_release) + 1);	//the spikes pushed before are in the channel when the writer sees the request
+	while(numberOfFlushesDone.load(memory_order_acquire) < request)
+	{
+		this_thread::yield();
+	}
+	checkWriter();
+}
+
+AsynchronousSpikeRecorder::BackpressureStatistics AsynchronousSpikeRecorder::getStatistics() const
+{ return statistics; }
+
+void AsynchronousSpikeRecorder::write()
+{
+	vector<SpikeRecord> records(NUMBER_OF_RECORDS_PER_POP);
+	vector<unsigned int> neuronIds;	//the spikes of the current step, which may come in several pops
+	unsigned int time(0);
+	while(true)
+	{
+		const unsigned long numberOfRequests(numberOfFlushRequests.load(memory_order_acquire));	//read before the channel, so that it is empty of the spikes preceding the requests once a pop finds nothing
+		const bool isLastRound(isStopping.load(memory_order_acquire));
+		const size_t numberOfRecords(channel.pop(records.data(), records.size()));
+		try
+		{
+			for(size_t i(0); i < numberOfRecords and not hasFailed.load(memory_order_relaxed); i++)
+			{
+				if(records[i].time != time)
+				{
+					passOn(time, neuronIds);
+					time = records[i].time;
+				}
+				neuronIds.push_back(records[i].neuronId);
+			}
+			if(numberOfRecords == 0 and (numberOfRequests > numberOfFlushesDone.load(memory_order_relaxed) or isLastRound) and not hasFailed.load(memory_order_relaxed))
+			{
+				passOn(time, neuronIds);
+				if(not isLastRound)	//the destructor of the recorder flushes it anyway
+				{
+					recorder->flush();
+				}
+			}
+		}
+		catch(...)	//handed over to the thread simulating the network
+		{
+			error = current_exception();
+			hasFailed.store(true, memory_order_release);
+		}
+		
+		if(numberOfRecords == 0)
+		{
+			numberOfFlushesDone.store(numberOfRequests, memory_order_release);	//only this thread writes it
+			if(isLastRound)
+			{
+				return;
+			}
+			this_thread::sleep_for(chrono::microseconds(IDLE_TIME));
+		}
+	}
+}
+
+void AsynchronousSpikeRecorder::passOn(unsigned int time, vector<unsigned int>& neuronIds)
+{
+	if(not neuronIds.empty())
+	{
+		recorder->record(time, neuronIds.data(), neuronIds.data() + neuronIds.size());
+		neuronIds.clear();
+	}
+}
+
+void AsynchronousSpikeRecorder::checkWriter()
+{
+	if(hasFailed.load(memory_order_acquire))
+	{
+		isErrorThrown = true;
+		rethrow_exception(error);
+	}
+}
@@ -0,0 +1,89 @@
+#ifndef ASYNCHRONOUS_SPIKE_RECORDER_H
+#define ASYNCHRONOUS_SPIKE_RECORDER_H
+
+#include "spikeChannel.hpp"
+#include "spikeRecorder.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/** A recorder that hands the spikes over to another recorder, for instance one writing a file, which runs on a writer thread of its own.
+ * The thread simulating the network only pushes the spikes into a SpikeChannel, the writer thread pops them and passes them on step after step, in the order they were recorded,
+   so that the simulation doesn't wait for the file unless the channel is full. It then waits until the writer has made room, which is counted in the backpressure statistics: 
+   no spike is ever dropped.
+ * An error of the recorder on the writer thread is thrown again by the next call to record() or flush().
+ * @see Simulation
+ * @see Network::addSpikeRecorder */
+class AsynchronousSpikeRecorder : public SpikeRecorder
+{
+	public:
+
+	/// How much the simulation had to wait for the writer thread.
+	struct BackpressureStatistics
+	{
+		unsigned long long numberOfSpikes; ///< The number of spikes recorded so far.
+		unsigned long long numberOfStalls; ///< The number of calls to record() that found the channel full.
+		double stallTime; ///< The time spent waiting for room in the channel, in s.
+		size_t maximalOccupancy; ///< The largest number of spikes in the channel after a push.
+	};
+
+	/** A constructor.
+	 * Starts the writer thread.
+	 * @param recorder the recorder the spikes are handed over to, only used by the writer thread from now on
+	 * @param capacity the number of spikes the channel holds, a size_t, rounded up to a power of two */
+	AsynchronousSpikeRecorder(std::unique_ptr<SpikeRecorder> recorder, size_t capacity);
+
+	/// A destructor which hands the remaining spikes over, stops the writer thread and then destroys the recorder, printing an error of the recorder to std::cerr unless it has already been thrown.
+	~AsynchronousSpikeRecorder() override;
+
+	AsynchronousSpikeRecorder(const AsynchronousSpikeRecorder&) = delete;
+	AsynchronousSpikeRecorder& operator=(const AsynchronousSpikeRecorder&) = delete;
+
+	/**Pushes the neurons that spiked in one step into the channel, waiting for room if it is full.
+	 * @throw any exception the recorder threw on the writer thread
+	 * @param time the step, an unsigned int
+	 * @param firstNeuronId a pointer to the id of the first spiking neuron
+	 * @param lastNeuronId a pointer past the id of the last spiking neuron */
+	void record(unsigned int time, const unsigned int* firstNeuronId, const unsigned int* lastNeuronId) override;
+
+	/**Waits until the writer thread has handed all spikes recorded so far over to the recorder and flushed it.
+	 * @throw any exception the recorder threw on the writer thread */
+	void flush() override;
+
+	/// A getter for the backpressure statistics, a BackpressureStatistics.
+	BackpressureStatistics getStatistics() const;
+
+	private:
+
+	static constexpr size_t NUMBER_OF_RECORDS_PER_POP = 4096; ///< The number of spikes the writer thread pops at once.
+	static constexpr unsigned int IDLE_TIME = 100; ///< The time the writer thread sleeps when the channel is empty, in µs.
+
+	std::unique_ptr<SpikeRecorder> recorder; ///< The recorder the spikes are handed over to.
+	SpikeChannel channel; ///< The spikes pushed but not yet popped.
+	BackpressureStatistics statistics; ///< Only accessed by the thread simulating the network.
+	std::atomic<unsigned long> numberOfFlushRequests; ///< The number of calls to flush() so far.
+	std::atomic<unsigned long> numberOfFlushesDone; ///< The number of calls to flush() the writer thread has answered.
+	std::atomic<bool> isStopping; ///< True once the recorder is being destroyed.
+	std::atomic<bool> hasFailed; ///< True once the recorder has thrown an exception, the later spikes are dropped.
+	std::exception_ptr error; ///< The exception the recorder threw, written by the writer thread before it sets hasFailed.
+	bool isErrorThrown; ///< True once the exception has been thrown again on the simulating thread.
+	std::thread writer; ///< The thread handing the spikes over to the recorder, started last.
+
+	/// The loop of the writer thread, popping the spikes until the recorder is destroyed.
+	void write();
+
+	/**Hands the spikes of one step gathered by the writer thread over to the recorder and clears them, if there are any.
+	 * @param time the step, an unsigned int
+	 * @param neuronIds the ids of the neurons that spiked */
+	void passOn(unsigned int time, std::vector<unsigned int>& neuronIds);
+
+	/**Throws the exception of the recorder again, if it has thrown one.
+	 * @throw any exception the recorder threw on the writer thread */
+	void checkWriter();
+};
+
+#endif
@@ -0,0 +1,60 @@
+#include "binarySpikeReader.hpp"
+#include "binarySpikeRecorder.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+BinarySpikeReader::BinarySpikeReader(const string& nameOfFile)
+:in(nameOfFile, ios::binary)
+,numberOfNeurons(0)
+,timeStep(0)
+,numberOfSpikes(0)
+,numberOfSpikesRead(0)
+{
+	uint32_t header[4];
+	in.read(reinterpret_cast<char*>(header), sizeof(header));
+	in.read(reinterpret_cast<char*>(&timeStep), sizeof(timeStep));
+	if(in.fail())
+	{
+		throw runtime_error("impossible to read the spike file " + nameOfFile);
+	}
+	if(header[0] != BinarySpikeRecorder::MAGIC_NUMBER or header[1] != BinarySpikeRecorder::VERSION)
+	{
+		throw runtime_error(nameOfFile + " isn't a spike file of version " + to_string(BinarySpikeRecorder::VERSION));
+	}
+	numberOfNeurons = header[2];
+	
+	in.seekg(0, ios::end);
+	numberOfSpikes = (static_cast<unsigned long long>(in.tellg()) - BinarySpikeRecorder::HEADER_SIZE)/sizeof(SpikeRecord);	//an incomplete last record is ignored
+	in.seekg(BinarySpikeRecorder::HEADER_SIZE);
+}
+
+unsigned int BinarySpikeReader::getNumberOfNeurons() const
+{ return numberOfNeurons; }
+
+double BinarySpikeReader::getTimeStep() const
+{ return timeStep; }
+
+unsigned long long BinarySpikeReader::getNumberOfSpikes() const
+{ return numberOfSpikes; }
+
+size_t BinarySpikeReader::read(SpikeRecord* records, size_t maximalNumberOfRecords)
+{
+	const size_t numberOfRecords(min<unsigned long long>(maximalNumberOfRecords, numberOfSpikes - numberOfSpikesRead));
+	in.read(reinterpret_cast<char*>(records), numberOfRecords*sizeof(SpikeRecord));
+	numberOfSpikesRead += numberOfRecords;
+	return numberOfRecords;
+}
+
+vector<SpikeRecord> BinarySpikeReader::readAll()
+{
+	vector<SpikeRecord> records(numberOfSpikes - numberOfSpikesRead);
+	read(records.data(), records.size());
+	return records;
+}
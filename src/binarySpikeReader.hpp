@@ -0,0 +1,51 @@
+#ifndef BINARY_SPIKE_READER_H
+#define BINARY_SPIKE_READER_H
+
+#include "spikeRecorder.hpp"
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/** Reads the spikes of a file written by a BinarySpikeRecorder, chunk after chunk so that files larger than the memory can be processed.
+ * @see BinarySpikeRecorder */
+class BinarySpikeReader
+{
+	public:
+
+	/** A constructor.
+	 * Opens the file and reads its header, the first call to read() yields the first spike.
+	 * @throw std::runtime_error if the file can't be read or isn't a spike file of a known version
+	 * @param nameOfFile a string */
+	explicit BinarySpikeReader(const std::string& nameOfFile);
+
+	/// A getter for the number of neurons of the recorded network.
+	unsigned int getNumberOfNeurons() const;
+
+	/// A getter for the duration of one step in ms.
+	double getTimeStep() const;
+
+	/// A getter for the number of spikes in the file, deduced from its size.
+	unsigned long long getNumberOfSpikes() const;
+
+	/**Reads the next spikes of the file.
+	 * @param records a pointer to the array receiving the spikes
+	 * @param maximalNumberOfRecords the size of the array, a size_t
+	 * @return the number of spikes read, zero once the end of the file is reached */
+	size_t read(SpikeRecord* records, size_t maximalNumberOfRecords);
+
+	/**Reads all the remaining spikes of the file at once.
+	 * @return the spikes in the order they were recorded, a vector of SpikeRecord */
+	std::vector<SpikeRecord> readAll();
+
+	private:
+
+	std::ifstream in; ///< The file.
+	unsigned int numberOfNeurons; ///< The number of neurons of the recorded network.
+	double timeStep; ///< The duration of one step in ms.
+	unsigned long long numberOfSpikes; ///< The number of spikes in the file.
+	unsigned long long numberOfSpikesRead; ///< The number of spikes read so far.
+};
+
+#endif
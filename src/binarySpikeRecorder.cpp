@@ -0,0 +1,81 @@
+#include "binarySpikeRecorder.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+constexpr uint32_t BinarySpikeRecorder::MAGIC_NUMBER;
+constexpr uint32_t BinarySpikeRecorder::VERSION;
+constexpr size_t BinarySpikeRecorder::HEADER_SIZE;
+constexpr size_t BinarySpikeRecorder::BUFFER_SIZE;
+
+static_assert(sizeof(SpikeRecord) == 2*sizeof(uint32_t), "the records are written as they are stored in memory");
+
+BinarySpikeRecorder::BinarySpikeRecorder(const string& nameOfFile, unsigned int numberOfNeurons, double timeStep)
+:nameOfFile(nameOfFile)
+,out(nameOfFile, ios::binary | ios::trunc)
+,numberOfSpikes(0)
+{
+	const uint32_t header[] = {MAGIC_NUMBER, VERSION, numberOfNeurons, 0};
+	out.write(reinterpret_cast<const char*>(header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(&timeStep), sizeof(timeStep));
+	static_assert(sizeof(header) + sizeof(double) == HEADER_SIZE, "the header has a fixed size");
+	if(out.fail())
+	{
+		throw runtime_error("impossible to write in file " + nameOfFile);
+	}
+	buffer.reserve(BUFFER_SIZE);
+}
+
+BinarySpikeRecorder::~BinarySpikeRecorder()
+{
+	if(out.fail())	//the write that failed has thrown to the owner, who has seen the error
+	{
+		return;
+	}
+	try
+	{
+		flush();
+	}
+	catch(const runtime_error& error)	//a destructor mustn't throw, but the spikes are lost
+	{
+		cerr << "Error: " << error.what() << endl;
+	}
+}
+
+void BinarySpikeRecorder::record(unsigned int time, const unsigned int* firstNeuronId, const unsigned int* lastNeuronId)
+{
+	for(const unsigned int* neuronId(firstNeuronId); neuronId != lastNeuronId; ++neuronId)
+	{
+		if(buffer.size() == BUFFER_SIZE)
+		{
+			writeBuffer();
+		}
+		buffer.push_back({time, *neuronId});
+	}
+	numberOfSpikes += lastNeuronId - firstNeuronId;
+}
+
+void BinarySpikeRecorder::flush()
+{
+	writeBuffer();
+	out.flush();
+}
+
+unsigned long long BinarySpikeRecorder::getNumberOfSpikes() const
+{ return numberOfSpikes; }
+
+void BinarySpikeRecorder::writeBuffer()
+{
+	out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size()*sizeof(SpikeRecord));
+	buffer.clear();
+	if(out.fail())
+	{
+		throw runtime_error("impossible to write in file " + nameOfFile);
+	}
+}
@@ -0,0 +1,65 @@
+#ifndef BINARY_SPIKE_RECORDER_H
+#define BINARY_SPIKE_RECORDER_H
+
+#include "spikeRecorder.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/** A recorder that streams the spikes to a compact binary file while the network is being simulated.
+ * The file starts with a header of HEADER_SIZE bytes: the magic number, the version of the format, the number of neurons, a word reserved for later use (zero) and the duration of a step in ms as a double.
+   It is followed by one SpikeRecord, that is to say two 32 bit words, per spike in the order of recording. All numbers are stored in the byte order of the machine.
+   The spikes are gathered in a buffer of BUFFER_SIZE records that is written at once when it is full, so that the simulation neither keeps all spikes in memory nor spends its time formatting text.
+ * @see BinarySpikeReader
+ * @see Network::addSpikeRecorder */
+class BinarySpikeRecorder : public SpikeRecorder
+{
+	public:
+
+	static constexpr std::uint32_t MAGIC_NUMBER = 0x4b505342; ///< "BSPK" in little endian, identifies the spike files.
+	static constexpr std::uint32_t VERSION = 1; ///< The version of the file format.
+	static constexpr size_t HEADER_SIZE = 24; ///< The number of bytes preceding the first spike.
+	static constexpr size_t BUFFER_SIZE = 1 << 16; ///< The number of spikes gathered before they are written, 512 KiB.
+
+	/** A constructor.
+	 * Creates the file, overwriting an existing one, and writes its header.
+	 * @throw std::runtime_error if the file can't be written
+	 * @param nameOfFile a string
+	 * @param numberOfNeurons the size of the recorded network, an unsigned int
+	 * @param timeStep the duration of one step in ms, a double */
+	BinarySpikeRecorder(const std::string& nameOfFile, unsigned int numberOfNeurons, double timeStep);
+
+	/// A destructor which writes the spikes that are still in the buffer, printing an error to std::cerr if they can't be written.
+	~BinarySpikeRecorder() override;
+
+	BinarySpikeRecorder(const BinarySpikeRecorder&) = delete;
+	BinarySpikeRecorder& operator=(const BinarySpikeRecorder&) = delete;
+
+	/**Appends the neurons that spiked in one step to the buffer, writing it if it is full.
+	 * @param time the step, an unsigned int
+	 * @param firstNeuronId a pointer to the id of the first spiking neuron
+	 * @param lastNeuronId a pointer past the id of the last spiking neuron */
+	void record(unsigned int time, const unsigned int* firstNeuronId, const unsigned int* lastNeuronId) override;
+
+	/// Writes the buffer and flushes the file, so that a reader sees all spikes recorded so far.
+	void flush() override;
+
+	/// A getter for the number of spikes recorded so far, an unsigned long long.
+	unsigned long long getNumberOfSpikes() const;
+
+	private:
+
+	std::string nameOfFile; ///< The name of the file, for the error messages.
+	std::ofstream out; ///< The file.
+	std::vector<SpikeRecord> buffer; ///< The spikes that haven't been written yet.
+	unsigned long long numberOfSpikes; ///< The number of spikes recorded so far.
+
+	/**Writes the spikes of the buffer to the file and empties it.
+	 * @throw std::runtime_error if the file can't be written */
+	void writeBuffer();
+};
+
+#endif
@@ -0,0 +1,84 @@
+#include "connectivity.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+Connectivity::Connectivity(size_t numberOfNeurons, size_t numberOfParts)
+:firstTargets(numberOfNeurons + 1, 0)
+,cursorsOfParts(numberOfParts, vector<uint32_t>(numberOfNeurons, 0))
+,isFrozen(false)
+{}
+
+void Connectivity::countConnection(unsigned int sourceId, unsigned int, size_t part)
+{
+	assert(not isFrozen and targets.empty());
+	assert(sourceId < getNumberOfNeurons() and part < cursorsOfParts.size());
+	cursorsOfParts[part][sourceId] ++;
+}
+
+void Connectivity::allocateTargets()
+{
+	for(size_t i(0); i < getNumberOfNeurons(); i++)
+	{
+		uint32_t numberOfTargets(0);
+		for(vector<uint32_t>& cursors: cursorsOfParts)	//the targets of a part follow the ones of the previous parts
+		{
+			const uint32_t numberOfTargetsOfPart(cursors[i]);
+			cursors[i] = numberOfTargets;
+			numberOfTargets += numberOfTargetsOfPart;
+		}
+		firstTargets[i + 1] = firstTargets[i] + numberOfTargets;
+	}
+	targets.resize(firstTargets.back());
+}
+
+void Connectivity::addConnection(unsigned int sourceId, unsigned int targetId, size_t part)
+{
+	assert(not isFrozen);
+	assert(sourceId < getNumberOfNeurons() and targetId < getNumberOfNeurons() and part < cursorsOfParts.size());
+	assert(firstTargets[sourceId] + cursorsOfParts[part][sourceId] < firstTargets[sourceId + 1]);
+	targets[firstTargets[sourceId] + cursorsOfParts[part][sourceId] ++] = targetId;
+}
+
+void Connectivity::freeze()
+{
+	vector<vector<uint32_t> >().swap(cursorsOfParts);	//the cursors aren't needed anymore
+	for(size_t i(0); i < getNumberOfNeurons(); i++)
+	{
+		uint32_t* const beginRow(targets.data() + firstTargets[i]);
+		uint32_t* const endRow(targets.data() + firstTargets[i + 1]);
+		if(not is_sorted(beginRow, endRow))	//the connections drawn target after target already are
+		{
+			sort(beginRow, endRow);
+		}
+	}
+	isFrozen = true;
+}
+
+size_t Connectivity::getNumberOfNeurons() const
+{ return firstTargets.size() - 1; }
+
+size_t Connectivity::getNumberOfConnections() const
+{ return targets.size(); }
+
+size_t Connectivity::getNumberOfTargets(unsigned int neuronId) const
+{
+	assert(isFrozen and neuronId < getNumberOfNeurons());
+	return firstTargets[neuronId + 1] - firstTargets[neuronId];
+}
+
+const uint32_t* Connectivity::beginTargets(unsigned int neuronId) const
+{
+	assert(isFrozen and neuronId < getNumberOfNeurons());
+	return targets.data() + firstTargets[neuronId];
+}
+
+const uint32_t* Connectivity::endTargets(unsigned int neuronId) const
+{
+	assert(isFrozen and neuronId < getNumberOfNeurons());
+	return targets.data() + firstTargets[neuronId + 1];
+}
@@ -0,0 +1,79 @@
+#ifndef CONNECTIVITY_H
+#define CONNECTIVITY_H
+
+#include "hugePageAllocator.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** The connections between the neurons of a network, stored as a compressed sparse row table.
+ * The ids of the targets of all neurons lie one after the other in a single array, the targets of neuron i being the entries from firstTargets[i] to firstTargets[i+1].
+   The table is built in two passes: every connection is first counted with countConnection() so that allocateTargets() can reserve the exact amount of memory,
+   then the very same connections are stored with addConnection(). After the second pass the table is frozen.
+ * The connections may be drawn by several threads at once, each one passing its own part to the table. The targets of a neuron are ordered by part first,
+   then in the order they were added, so that the table doesn't depend on how many threads drew it as long as each part covers the same connections.
+ * @see Network::establishConnections() */
+class Connectivity
+{
+	public:
+
+	/** A constructor.
+	 * Creates a table of neurons without any connection.
+	 * @param numberOfNeurons a size_t
+	 * @param numberOfParts the number of threads that add connections concurrently, a size_t */
+	explicit Connectivity(size_t numberOfNeurons, size_t numberOfParts = 1);
+
+	//building
+	/**First pass, counts a connection from a presynaptic neuron to a target. Different parts may be counted concurrently.
+	 * @param sourceId the id of the presynaptic neuron, an unsigned int
+	 * @param targetId the id of the postsynaptic neuron, an unsigned int
+	 * @param part the part of the connection, a size_t */
+	void countConnection(unsigned int sourceId, unsigned int targetId, size_t part = 0);
+
+	/**Reserves the memory for the connections counted during the first pass, must be called between the two passes.*/
+	void allocateTargets();
+
+	/**Second pass, stores a connection from a presynaptic neuron to a target. The connections of each neuron and part must be added in the same number as they were counted.
+	   Different parts may be added concurrently.
+	 * @param sourceId the id of the presynaptic neuron, an unsigned int
+	 * @param targetId the id of the postsynaptic neuron, an unsigned int
+	 * @param part the part of the connection, a size_t */
+	void addConnection(unsigned int sourceId, unsigned int targetId, size_t part = 0);
+
+	/**Ends the second pass by sorting the targets of each neuron, from then on the table is ready to be read.
+	 * The spikes of a neuron are thus delivered in increasing order of addresses, and the targets in a range of neurons can be found by bisection.*/
+	void freeze();
+
+	//getters
+	/// A getter for the number of neurons in the table.
+	size_t getNumberOfNeurons() const;
+
+	/// A getter for the total number of connections in the table.
+	size_t getNumberOfConnections() const;
+
+	/** A getter of the number of targets a neuron has.
+	 * @param neuronId an unsigned int
+	 * @return a size_t */
+	size_t getNumberOfTargets(unsigned int neuronId) const;
+
+	/** A getter of a pointer to the first target of a neuron.
+	 * @see Network::deliverSpikes
+	 * @param neuronId an unsigned int
+	 * @return a pointer to the id of the neuron's first target */
+	const std::uint32_t* beginTargets(unsigned int neuronId) const;
+
+	/** A getter of a pointer past the last target of a neuron.
+	 * @param neuronId an unsigned int
+	 * @return a pointer past the id of the neuron's last target */
+	const std::uint32_t* endTargets(unsigned int neuronId) const;
+
+	private:
+
+	std::vector<size_t> firstTargets; ///< The offsets of each neuron's targets in the array of targets, with one more entry marking the end of the table, 64 bit wide since millions of neurons may have more than 2^32 connections.
+	std::vector<std::uint32_t, HugePageAllocator<std::uint32_t> > targets; ///< The ids of the postsynaptic neurons of all neurons, four bytes per connection, in huge pages since they are read in random order.
+	std::vector<std::vector<std::uint32_t> > cursorsOfParts; ///< While the table is built, for each part and neuron the number of targets counted, then the position of the next target to add relative to the neuron's first one.
+	bool isFrozen; ///< True once the second pass is over.
+};
+
+#endif
@@ -0,0 +1,51 @@
+#include "counterBasedGenerator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+using namespace std;
+
+CounterBasedGenerator::CounterBasedGenerator(unsigned int seed, unsigned int streamId, unsigned int position)
+:counter({{0, position, streamId, 0}})
+,key({{seed, 0}})
+,block()
+,numberOfWordsUsed(block.size())	//the first call computes the first block
+{}
+
+array<uint32_t, 4> CounterBasedGenerator::philox(array<uint32_t, 4> counter, array<uint32_t, 2> key)
+{
+	constexpr uint64_t MULTIPLIER_0(0xD2511F53);	//the constants of Philox4x32
+	constexpr uint64_t MULTIPLIER_1(0xCD9E8D57);
+	constexpr uint32_t KEY_INCREMENT_0(0x9E3779B9);
+	constexpr uint32_t KEY_INCREMENT_1(0xBB67AE85);
+	constexpr unsigned int NUMBER_OF_ROUNDS(10);
+
+	for(unsigned int round(0); round < NUMBER_OF_ROUNDS; round++)
+	{
+		if(round > 0)
+		{
+			key[0] += KEY_INCREMENT_0;
+			key[1] += KEY_INCREMENT_1;
+		}
+		const uint64_t product0(MULTIPLIER_0*counter[0]);
+		const uint64_t product1(MULTIPLIER_1*counter[2]);
+		counter = {{static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0], static_cast<uint32_t>(product1),
+		            static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1], static_cast<uint32_t>(product0)}};
+	}
+	return counter;
+}
+
+void CounterBasedGenerator::generate(unsigned int seed, unsigned int position, size_t firstStreamId, size_t lastStreamId, uint32_t* numbers)
+{
+	const array<uint32_t, 2> key = {{seed, 0}};
+	const size_t BLOCK_LENGTH(4);
+	for(size_t blockId(firstStreamId/BLOCK_LENGTH); blockId*BLOCK_LENGTH < lastStreamId; blockId++)
+	{
+		const array<uint32_t, 4> block(philox({{0, position, static_cast<uint32_t>(blockId), 1}}, key));	//the last word distinguishes these blocks from the sequences of the generators
+		for(size_t i(std::max(blockId*BLOCK_LENGTH, firstStreamId)); i < std::min((blockId + 1)*BLOCK_LENGTH, lastStreamId); i++)
+		{
+			numbers[i - firstStreamId] = block[i%BLOCK_LENGTH];
+		}
+	}
+}
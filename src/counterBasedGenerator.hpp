@@ -0,0 +1,70 @@
+#ifndef COUNTER_BASED_GENERATOR_H
+#define COUNTER_BASED_GENERATOR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/** A random generator whose numbers are a function of a seed, a stream id and a position, for instance a neuron id and a simulation step.
+ * It is based on the Philox4x32-10 bijection (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", 2011), which scrambles a 128 bit counter with a 64 bit key.
+   Unlike a sequential generator it has no state shared among neurons: the numbers a neuron receives in a step don't depend on the order in which the neurons are updated nor on the thread that updates them.
+   It satisfies the requirements of a uniform random bit generator and can thus be passed to the distributions of the standard library.
+ * @see NeuronPopulation::addBackgroundNoise
+ * @see Neuron::getBackgroundNoise() */
+class CounterBasedGenerator
+{
+	public:
+
+	typedef std::uint32_t result_type; ///< The type of the generated numbers.
+
+	/** A constructor.
+	 * Positions the generator at the beginning of the sequence of numbers identified by its arguments.
+	 * @param seed an unsigned int
+	 * @param streamId an unsigned int, for instance a neuron id
+	 * @param position an unsigned int, for instance a simulation step */
+	CounterBasedGenerator(unsigned int seed, unsigned int streamId, unsigned int position);
+
+	/// The smallest number the generator can yield.
+	static constexpr result_type min() { return 0; }
+	/// The largest number the generator can yield.
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+	/** Yields the next number of the sequence, computing a new block of four numbers every fourth call.
+	 * Defined in the header so that it can be inlined in the update loops.
+	 * @return a uniformly distributed 32 bit number */
+	result_type operator()()
+	{
+		if(numberOfWordsUsed == block.size())
+		{
+			block = philox(counter, key);
+			counter[0] ++;
+			numberOfWordsUsed = 0;
+		}
+		return block[numberOfWordsUsed++];
+	}
+
+	/** The Philox4x32-10 bijection.
+	 * @param counter four 32 bit words
+	 * @param key two 32 bit words
+	 * @return four 32 bit words that look uniformly random */
+	static std::array<std::uint32_t, 4> philox(std::array<std::uint32_t, 4> counter, std::array<std::uint32_t, 2> key);
+
+	/** Computes one number for each stream of a range at a given position, the streams sharing each block of four numbers four by four.
+	 * The number of a stream only depends on the seed, the stream id and the position, not on the range it is computed with.
+	 * @param seed an unsigned int
+	 * @param position an unsigned int, for instance a simulation step
+	 * @param firstStreamId the first stream id of the range
+	 * @param lastStreamId the stream id following the range
+	 * @param numbers a pointer to the array receiving the numbers, whose first entry corresponds to the first stream id */
+	static void generate(unsigned int seed, unsigned int position, size_t firstStreamId, size_t lastStreamId, std::uint32_t* numbers);
+
+	private:
+
+	std::array<std::uint32_t, 4> counter; ///< The number of blocks computed so far, the position and the stream id.
+	std::array<std::uint32_t, 2> key; ///< The seed.
+	std::array<std::uint32_t, 4> block; ///< The last block of four numbers.
+	size_t numberOfWordsUsed; ///< The number of words of the block that were already returned.
+};
+
+#endif
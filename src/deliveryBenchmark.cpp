@@ -0,0 +1,75 @@
+#include "network.hpp"
+#include "simulationConfig.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/* Compares the strategies of delivery of the spikes, see Network::DeliveryStrategy, in regimes of Brunel's phase diagram whose numbers of spikes per step differ by orders of magnitude.
+ * The network is the one of the parameter file, simulated for 1000 steps, unless "name=value" pairs or "config=fileName" are given on the command line, as for ./neuron, and the spikes are always counted.
+ * Prints one line per regime with the number of spikes each neuron receives per step and the time each strategy needs to simulate finalTime steps. */
+int main(int argc, char* argv[])
+{
+	SimulationConfig config;
+	config.finalTime = 1000;	//a benchmark doesn't need the seconds of Brunel's figures nor prints any spike
+	config.timeBeginMeasurement = 0;
+	config.timeBeginPrintToTxtFile = 0;
+	config.timeEndPrintToTxtFile = 0;
+	try
+	{
+		config.readCommandLine(argc, argv);
+		config.isCountingSpikes = true;	//the only representation several threads can deliver to
+		config.validate();
+	}
+	catch(const invalid_argument& error)
+	{
+		cerr << "Error: " << error.what() << endl;
+		return 1;
+	}
+
+	const vector<pair<double, double> > regimes({{3, 2}, {4, 2}, {5, 2}, {4.5, 0.9}, {6, 4}});	//(g, Vext/Vthr), from synchronous bursts to sparse irregular firing
+	const vector<pair<Network::DeliveryStrategy, const char*> > strategies({{Network::DeliveryStrategy::byRangeOfTargets, "byRange[s]"},
+	                                                                         {Network::DeliveryStrategy::atomic, "atomic[s]"},
+	                                                                         {Network::DeliveryStrategy::privatized, "privatized[s]"},
+	                                                                         {Network::DeliveryStrategy::automatic, "automatic[s]"}});
+	const shared_ptr<const Connectivity> connections(Network::createConnections(config));
+
+	cout << "# " << config.numberOfNeurons << " neurons, " << config.finalTime << " steps, " << Network(config, connections).getNumberOfThreads() << " threads" << endl;
+	cout << "# g\tVext/Vthr\tspikesPerNeuronAndStep";
+	for(const auto& strategy: strategies)
+	{
+		cout << '\t' << strategy.second;
+	}
+	cout << endl;
+
+	for(const auto& regime: regimes)
+	{
+		cout << regime.first << '\t' << regime.second << flush;
+		for(size_t i(0); i < strategies.size(); i++)
+		{
+			SimulationConfig configOfRegime(config);
+			configOfRegime.ratioJinOverJexG = regime.first;
+			configOfRegime.ratioVextOverVthr = regime.second;
+			Network network(configOfRegime, connections);
+			network.setDeliveryStrategy(strategies[i].first);
+
+			const chrono::steady_clock::time_point start(chrono::steady_clock::now());
+			network.update(config.finalTime);
+			const double duration(chrono::duration<double>(chrono::steady_clock::now() - start).count());
+			if(i == 0)	//the same spikes whatever the strategy
+			{
+				const double meanSpikeRate(network.getMeanSpikeRateInInterval(0, config.finalTime));
+				cout << '\t' << setprecision(3) << meanSpikeRate*config.timeStepH*0.001*connections->getNumberOfConnections()/config.numberOfNeurons;
+			}
+			cout << '\t' << setprecision(3) << duration << flush;
+		}
+		cout << endl;
+	}
+	return 0;
+}
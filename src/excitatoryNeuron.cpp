@@ -4,8 +4,8 @@
 
 using namespace std;
 
-ExcitatoryNeuron::ExcitatoryNeuron()
-:Neuron()
+ExcitatoryNeuron::ExcitatoryNeuron(unsigned int id, unsigned int seed)
+:Neuron(id, seed)
 {}
 
 double ExcitatoryNeuron::getSpikeAmplitude() const
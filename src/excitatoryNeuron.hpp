@@ -10,8 +10,10 @@ class ExcitatoryNeuron : public Neuron
 {
 	public:
 	
-	///A constructor, calling the constructor of the superclass Neuron.
-	ExcitatoryNeuron();
+	/**A constructor, calling the constructor of the superclass Neuron.
+	 * @param id the neuron's id, an unsigned int
+	 * @param seed the seed of the background noise, an unsigned int */
+	explicit ExcitatoryNeuron(unsigned int id = 0, unsigned int seed = NOISE_SEED_BY_DEFAULT);
 	
 	private:
 	
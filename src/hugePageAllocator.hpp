@@ -0,0 +1,91 @@
+#ifndef HUGE_PAGE_ALLOCATOR_H
+#define HUGE_PAGE_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+/** An allocator for the large arrays of a network, such as its connections and its ring buffers, which may take gigabytes for millions of neurons.
+ * The arrays of at least one huge page are aligned on huge page boundaries and the kernel is advised to back them with huge pages,
+   so that walking them randomly, as the delivery of spikes does, needs 512 times fewer TLB entries than with ordinary pages. Smaller arrays are allocated as usual.
+ * It can be used by std::vector, the elements are stored exactly as with the default allocator.
+ * @see Connectivity
+ * @see NeuronPopulation */
+template<typename T>
+class HugePageAllocator
+{
+	public:
+
+	typedef T value_type; ///< The type of the elements.
+
+	static constexpr std::size_t HUGE_PAGE_SIZE = 2*1024*1024; ///< The size of a huge page of the x86-64 and ARM64 processors, in bytes.
+
+	/// A constructor.
+	HugePageAllocator() = default;
+
+	/// A constructor from an allocator of another type, required by the standard containers.
+	template<typename U>
+	HugePageAllocator(const HugePageAllocator<U>&) {}
+
+	/// The largest number of elements whose size in bytes fits into a size_t.
+	std::size_t max_size() const
+	{ return static_cast<std::size_t>(-1)/sizeof(T); }
+
+	/** Allocates an array.
+	 * @throw std::bad_array_new_length if the size of the array in bytes doesn't fit into a size_t
+	 * @throw std::bad_alloc if there isn't enough memory
+	 * @param numberOfElements a size_t
+	 * @return a pointer to the first element, not initialized */
+	T* allocate(std::size_t numberOfElements)
+	{
+		if(numberOfElements > max_size())	//the size would wrap around to a small array
+		{
+			throw std::bad_array_new_length();
+		}
+		const std::size_t size(numberOfElements*sizeof(T));
+		if(size < HUGE_PAGE_SIZE)
+		{
+			return static_cast<T*>(::operator new(size));
+		}
+		void* memory(nullptr);
+		if(posix_memalign(&memory, HUGE_PAGE_SIZE, size) != 0)
+		{
+			throw std::bad_alloc();
+		}
+#ifdef MADV_HUGEPAGE
+		madvise(memory, size, MADV_HUGEPAGE);	//only a hint, the array is usable whether the kernel follows it or not
+#endif
+		return static_cast<T*>(memory);
+	}
+
+	/** Frees an array.
+	 * @param elements a pointer returned by allocate()
+	 * @param numberOfElements the size given to allocate(), a size_t */
+	void deallocate(T* elements, std::size_t numberOfElements)
+	{
+		if(numberOfElements*sizeof(T) < HUGE_PAGE_SIZE)
+		{
+			::operator delete(elements);
+		}
+		else
+		{
+			free(elements);
+		}
+	}
+};
+
+/// Any two allocators can free each other's arrays.
+template<typename T, typename U>
+bool operator==(const HugePageAllocator<T>&, const HugePageAllocator<U>&)
+{ return true; }
+
+/// Any two allocators can free each other's arrays.
+template<typename T, typename U>
+bool operator!=(const HugePageAllocator<T>&, const HugePageAllocator<U>&)
+{ return false; }
+
+#endif
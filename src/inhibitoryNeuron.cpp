@@ -5,8 +5,8 @@ using namespace std;
 
 double InhibitoryNeuron::ratioJinoverJexG(J_INHIBATORY_OVER_J_EXCITATORY_G); //Initializes the inhibitory neuron's static attribute ratioJinoverJexG
 
-InhibitoryNeuron::InhibitoryNeuron()
-:Neuron()
+InhibitoryNeuron::InhibitoryNeuron(unsigned int id, unsigned int seed)
+:Neuron(id, seed)
 {}
 
 double InhibitoryNeuron::getSpikeAmplitude() const
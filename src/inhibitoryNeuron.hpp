@@ -10,8 +10,10 @@ class InhibitoryNeuron : public Neuron
 {
 	public:
 	
-	///A constructor, calling the constructor of the superclass Neuron.
-	InhibitoryNeuron();
+	/**A constructor, calling the constructor of the superclass Neuron.
+	 * @param id the neuron's id, an unsigned int
+	 * @param seed the seed of the background noise, an unsigned int */
+	explicit InhibitoryNeuron(unsigned int id = 0, unsigned int seed = NOISE_SEED_BY_DEFAULT);
 	
 	/**A setter of the static attribute ratioJinoverJexG.
 	 * Sets the static attribute and simulation parameter ratioJinoverJexG which, 
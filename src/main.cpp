@@ -1,4 +1,6 @@
+#include "parameterSweep.hpp"
 #include "simulation.hpp"
+#include "simulationConfig.hpp"
 #include "network.hpp"
 #include "neuron.hpp"
 #include "parameters.hpp"
@@ -6,12 +8,43 @@
 
 #include <cassert>
 #include <iostream>
+#include <stdexcept>
 
 using namespace std;
 
 
-int main()
+int main(int argc, char* argv[])
 {
-	Simulation simulation;
-	return(simulation.runBrunel());
+	SimulationConfig config;	//the parameter file's values unless "name=value" pairs or "config=fileName" are given on the command line
+	try
+	{
+		config.readCommandLine(argc, argv);
+		config.validate();
+	}
+	catch(const invalid_argument& error)
+	{
+		cerr << "Error: " << error.what() << endl;
+		return 1;
+	}
+	
+	try
+	{
+		if(config.isSweep())	//the table of a phase diagram instead of one of Brunel's figures
+		{
+			ParameterSweep sweep(config);
+			sweep.addGrid(config.sweepRatiosJinOverJexG, config.sweepRatiosVextOverVthr);
+			cout << "The " << config.sweepRatiosJinOverJexG.size()*config.sweepRatiosVextOverVthr.size() << " points of the parameter sweep get simulated. This can take a moment. Please be patient!" << endl;
+			sweep.run();
+			sweep.writeTable(config.nameOfSweepFile);
+			cout << "The mean spike rates have been written to " << config.nameOfSweepFile << "." << endl;
+			return 0;
+		}
+		Simulation simulation(config);
+		return(simulation.runBrunel());
+	}
+	catch(const runtime_error& error)	//the spike, the raster or the sweep file can't be written
+	{
+		cerr << "Error: " << error.what() << endl;
+		return 1;
+	}
 }
@@ -1,185 +1,529 @@
-#include "excitatoryNeuron.hpp"
-#include "inhibitoryNeuron.hpp"
+#include "connectivity.hpp"
+#include "counterBasedGenerator.hpp"
 #include "network.hpp"
-#include "neuron.hpp"
+#include "neuronPopulation.hpp"
 #include "parameters.hpp"
-#include "simulation.hpp"
+#include "workerPool.hpp"
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <random>
+#include <stdexcept>
+#include <thread>
 
 using namespace std;
 
-Network::Network()
+namespace
 {
-		createNeurons();//creation of neurons
-		establishConnections();//establishing connections
+	/** The default configuration except for the number of threads and the seed.
+	 * @param numberOfThreads a size_t
+	 * @param seed an unsigned int */
+	SimulationConfig getConfigWithThreadsAndSeed(size_t numberOfThreads, unsigned int seed)
+	{
+		SimulationConfig config;
+		config.numberOfThreads = numberOfThreads;
+		config.seed = seed;
+		return config;
+	}
+}
+
+template<typename State>
+BasicNetwork<State>::BasicNetwork()
+:BasicNetwork(SimulationConfig())
+{}
+
+template<typename State>
+BasicNetwork<State>::BasicNetwork(size_t numberOfThreads, unsigned int seed)
+:BasicNetwork(getConfigWithThreadsAndSeed(numberOfThreads, seed))
+{}
+
+template<typename State>
+BasicNetwork<State>::BasicNetwork(const SimulationConfig& config)
+:BasicNetwork(config, createConnections(config))
+{}
+
+template<typename State>
+BasicNetwork<State>::BasicNetwork(const SimulationConfig& config, shared_ptr<const Connectivity> connections)
+:config(config)
+,numberOfExcitatoryNeurons(config.getNumberOfExcitatoryNeurons())
+,neurons(config.numberOfNeurons, (config.seed != 0) ? config.seed : random_device()(), config)
+,excitatorySpikeAmplitude(config.spikeAmplitudeJExcitatory)
+,inhibitorySpikeAmplitude(-(config.spikeAmplitudeJExcitatory*config.ratioJinOverJexG))
+,connections(connections)
+,workers(config.numberOfThreads > 0 ? config.numberOfThreads : max(thread::hardware_concurrency(), 1u))
+,bucketsOfWorkers(workers.size())
+,maximalNumberOfStepsPerRound(1)
+,isBucketedDeliveryAllowed(false)
+,deliveryStrategy(DeliveryStrategy::byRangeOfTargets)
+,privateSpikeCountsOfWorkers(workers.size())
+{
+	if(this->connections == nullptr or this->connections->getNumberOfNeurons() != config.numberOfNeurons)
+	{
+		throw invalid_argument("the table of connections doesn't match the size of the network");
+	}
+	//all the presynaptic neurons of a neuron can spike in the same step, their spikes then land in the same slot of its ring buffer
+	const double maximalInputOfOneStep((config.getNumberOfConnectionsFromExcitatoryNeurons() + config.ratioJinOverJexG*config.getNumberOfConnectionsFromInhibitoryNeurons())*fabs(config.spikeAmplitudeJExcitatory));
+	if(maximalInputOfOneStep > StateRepresentation<State>(config.spikeAmplitudeJExcitatory).toMillivolts(numeric_limits<State>::max()))
+	{
+		throw invalid_argument("the spikes a neuron can receive in one step overflow the representation of its state");
+	}
+	createNeurons();//creation of neurons
+	
+	//each chunk is a range of whole blocks of neurons, so that the background noise doesn't depend on the number of threads
+	const size_t numberOfBlocks((neurons.size() + BasicNeuronPopulation<State>::BLOCK_SIZE - 1)/BasicNeuronPopulation<State>::BLOCK_SIZE);
+	const size_t numberOfChunks((workers.size() > 1) ? max<size_t>(min(numberOfBlocks, workers.size()*NUMBER_OF_CHUNKS_PER_WORKER), 1) : 1);	//a single worker delivers to all neurons at once, without looking for the targets of a chunk
+	for(size_t chunk(0); chunk <= numberOfChunks; chunk++)
+	{
+		firstNeuronOfChunks.push_back(min(neurons.size(), chunk*numberOfBlocks/numberOfChunks*BasicNeuronPopulation<State>::BLOCK_SIZE));
+	}
+	spikingNeuronsOfChunks.resize(numberOfChunks);
+	firstSpikeOfStepsOfChunks.resize(numberOfChunks);
+	
+	setBatchedCommunication(true);
 }
 
-Network::~Network() //neurons can't exist without a network
+template<typename State>
+void BasicNetwork<State>::update()
 {
-    for (auto& neuron : neurons) {
-        delete neuron;
-        neuron = nullptr;
-    }
+	updateRound(1);
 }
 
-void Network::update()
+template<typename State>
+void BasicNetwork<State>::update(unsigned int numberOfSteps)
 {
-	for(auto& neuron: neurons)
+	while(numberOfSteps > 0)
 	{
-		assert(neuron!=nullptr);
-		neuron->update();
+		const unsigned int numberOfStepsInRound(min(numberOfSteps, maximalNumberOfStepsPerRound));
+		updateRound(numberOfStepsInRound);
+		numberOfSteps -= numberOfStepsInRound;
 	}
 }
 
+template<typename State>
+void BasicNetwork<State>::setBucketedDelivery(bool isAllowed)
+{
+	isBucketedDeliveryAllowed = isAllowed;
+}
 
-void Network::printSimulationData(const std::string& nameOfFile) const //allows to write only spikes in a certain interval into a file
+template<typename State>
+void BasicNetwork<State>::setBatchedCommunication(bool isBatched)
 {
-	printSimulationData(nameOfFile,&Network::getIteratorToBegin,&Network::getIteratorToEnd);
+	maximalNumberOfStepsPerRound = (isBatched and neurons.getSignalDelay() > 0) ? neurons.getSignalDelay() : 1;
 }
 
-void Network::printSimulationDataWithinTimeInterval(const std::string& nameOfFile) const
+template<typename State>
+void BasicNetwork<State>::setDeliveryStrategy(DeliveryStrategy strategy)
 {
-	printSimulationData(nameOfFile,&Network::getIteratorToBeginInterval,&Network::getIteratorToEndInterval);
+	if(strategy != DeliveryStrategy::byRangeOfTargets and not neurons.isCountingSpikes())
+	{
+		throw invalid_argument("several threads can only deliver spikes to the same neurons if the spikes are counted");
+	}
+	deliveryStrategy = strategy;
 }
 
-double Network::getMeanSpikeRateInInterval(unsigned int beginInterval, unsigned int endInterval) const
+template<typename State>
+void BasicNetwork<State>::addSpikeRecorder(SpikeRecorder* recorder, unsigned int beginWindow, unsigned int endWindow)
 {
-	assert(endInterval >= beginInterval and endInterval<=FINAL_TIME);
+	assert(recorder != nullptr and beginWindow <= endWindow);
+	spikeRecorders.push_back({recorder, beginWindow, endWindow});
+}
+
+template<typename State>
+void BasicNetwork<State>::removeSpikeRecorder(SpikeRecorder* recorder)
+{
+	spikeRecorders.erase(remove_if(spikeRecorders.begin(), spikeRecorders.end(), [recorder](const RecordingWindow& window){ return window.recorder == recorder; }), spikeRecorders.end());
+}
+
+template<typename State>
+const SimulationConfig& BasicNetwork<State>::getConfig() const
+{
+	return config;
+}
+
+template<typename State>
+unsigned int BasicNetwork<State>::getInternalTime() const
+{
+	return neurons.getInternalTime();
+}
+
+template<typename State>
+size_t BasicNetwork<State>::getNumberOfThreads() const
+{
+	return workers.size();
+}
+
+template<typename State>
+double BasicNetwork<State>::getMembranePotential(unsigned int neuronId) const
+{
+	return neurons.getMembranePotential(neuronId);
+}
+
+template<typename State>
+shared_ptr<const Connectivity> BasicNetwork<State>::getConnections() const
+{
+	return connections;
+}
+
+template<typename State>
+void BasicNetwork<State>::setRatioJinoverJexG(double ratioJinoverJexG)
+{
+	inhibitorySpikeAmplitude = -(config.spikeAmplitudeJExcitatory*ratioJinoverJexG);
+	neurons.setSpikeAmplitudes(excitatorySpikeAmplitude, inhibitorySpikeAmplitude);	//the only amplitudes the neurons receive if they count the spikes
+}
+
+template<typename State>
+void BasicNetwork<State>::setRatioVextOverVthr(double ratioVextOverVthr)
+{
+	neurons.setRatioVextOverVthr(ratioVextOverVthr);
+}
+
+
+template<typename State>
+double BasicNetwork<State>::getMeanSpikeRateInInterval(unsigned int beginInterval, unsigned int endInterval) const
+{
+	assert(endInterval >= beginInterval and endInterval<=neurons.getInternalTime());
 	double meanFrequency(0);
-	for(auto const& neuron: neurons)
-			{
-				
-				if(not neuron->getSpikeTime().empty() )
-				{
-					for(vector<unsigned int>::const_iterator it = lower_bound(neuron->getSpikeTime().begin(), neuron->getSpikeTime().end(), beginInterval); it != upper_bound(neuron->getSpikeTime().begin(), neuron->getSpikeTime().end(), endInterval); ++it)
-					{
-						meanFrequency ++;
-					}
-			}
-		}
-		return meanFrequency/=(neurons.size()*(endInterval-beginInterval)*MIN_TIME_INTERVAL_H*0.001);
+	for(unsigned int time(beginInterval); time <= endInterval and time - INITIAL_TIME < numberOfSpikesOfSteps.size(); time++)	//the bounds are part of the interval
+	{
+		meanFrequency += numberOfSpikesOfSteps[time - INITIAL_TIME];
+	}
+	return meanFrequency/=(neurons.size()*(endInterval-beginInterval)*config.timeStepH*0.001);
 }
 
 //testing connectivity
-double Network::getMeanNumberOfTargetsPerNeuron() const
+template<typename State>
+double BasicNetwork<State>::getMeanNumberOfTargetsPerNeuron() const
 {
-	return getMeanNumberOfTargetsPerNeuron(&Neuron::getNumberOfTargets);
+	return getMeanNumberOfTargetsPerNeuron(&BasicNetwork::getNumberOfTargets);
 }
 
-double Network::getMeanNumberOfExcitatoryTargetsPerNeuron() const
+template<typename State>
+double BasicNetwork<State>::getMeanNumberOfExcitatoryTargetsPerNeuron() const
+{
+	return getMeanNumberOfTargetsPerNeuron(&BasicNetwork::getNumberOfExcitatoryTargets);
+}
+
+
+//creation of network
+	
+template<typename State>
+void BasicNetwork<State>::createNeurons()
 {
-	return getMeanNumberOfTargetsPerNeuron(&Neuron::getNumberOfExcitatoryTargets);
+	assert(config.percentExcitatoryNeurons >=0);//Beware of negative number of neurons
+	assert(neurons.size()>=numberOfExcitatoryNeurons);
+	assert(neurons.size()==config.numberOfNeurons);
+	
+	excitatorySpikeAmplitude = config.spikeAmplitudeJExcitatory;	//neurons 0 to Ne-1
+	setRatioJinoverJexG(config.ratioJinOverJexG);	//neurons Ne to N-1
 }
 
+template<typename State>
+shared_ptr<const Connectivity> BasicNetwork<State>::createConnections(const SimulationConfig& config)
+{
+	const size_t numberOfBlocks((config.numberOfNeurons + NUMBER_OF_TARGETS_PER_BLOCK - 1)/NUMBER_OF_TARGETS_PER_BLOCK);
+	const size_t numberOfThreads(config.numberOfThreads > 0 ? config.numberOfThreads : max(thread::hardware_concurrency(), 1u));
+	WorkerPool workers(max<size_t>(min(numberOfThreads, numberOfBlocks), 1));
+	shared_ptr<Connectivity> connections(make_shared<Connectivity>(config.numberOfNeurons, workers.size()));	//each worker fills its own part, the parts follow the order of the blocks
+	const auto drawBlocksOfWorker = [&](void (Connectivity::*connect)(unsigned int, unsigned int, size_t), size_t workerId)
+	{
+		establishConnections(config, *connections, connect, workerId, workerId*numberOfBlocks/workers.size(), (workerId + 1)*numberOfBlocks/workers.size());
+	};
+	
+	workers.run([&](size_t workerId){ drawBlocksOfWorker(&Connectivity::countConnection, workerId); });	//first pass, counts the targets of each neuron
+	connections->allocateTargets();
+	workers.run([&](size_t workerId){ drawBlocksOfWorker(&Connectivity::addConnection, workerId); });	//second pass, the same connections are drawn again and stored
+	connections->freeze();
+	return connections;
+}
 
-vector<unsigned int>::const_iterator Network::getIteratorToBeginInterval(unsigned int neuronId) const
+template<typename State>
+void BasicNetwork<State>::establishConnections(const SimulationConfig& config, Connectivity& connections, void (Connectivity::*connect)(unsigned int, unsigned int, size_t), size_t part, size_t firstBlock, size_t lastBlock)
+{
+	const uint64_t numberOfExcitatoryNeurons(config.getNumberOfExcitatoryNeurons());
+	const uint64_t numberOfInhibitoryNeurons(config.getNumberOfInhibitoryNeurons());
+	const unsigned int numberOfConnectionsFromExcitatoryNeurons(config.getNumberOfConnectionsFromExcitatoryNeurons());
+	const unsigned int numberOfConnectionsFromInhibitoryNeurons(config.getNumberOfConnectionsFromInhibitoryNeurons());
+	assert(connections.getNumberOfNeurons()==config.numberOfNeurons);
+	
+	for(size_t block(firstBlock); block < lastBlock; block++)
 	{
-		assert(neuronId<neurons.size());
-		return lower_bound(neurons[neuronId]->getSpikeTime().begin(), neurons[neuronId]->getSpikeTime().end(), Simulation::getTimeBeginPrintToTxtFile());
+		CounterBasedGenerator randomGenerator(config.connectionSeed, block, 0);	//the same sequence in both passes and whichever thread draws the block
+		for(size_t neuron(block*NUMBER_OF_TARGETS_PER_BLOCK); neuron < min<size_t>((block + 1)*NUMBER_OF_TARGETS_PER_BLOCK, config.numberOfNeurons); neuron++)
+		{
+			for(size_t i(0); i < numberOfConnectionsFromExcitatoryNeurons; i++)
+			{
+				(connections.*connect)((randomGenerator()*numberOfExcitatoryNeurons) >> 32, neuron, part);	//maps a 32 bit number to the excitatory neurons without a division, the bias is negligible. Can stimulate itself???
+			}
+			
+			for(size_t i(0); i < numberOfConnectionsFromInhibitoryNeurons; i++)
+			{
+				(connections.*connect)(numberOfExcitatoryNeurons + ((randomGenerator()*numberOfInhibitoryNeurons) >> 32), neuron, part);
+			}
+		}
 	}
+}
 
-vector<unsigned int>::const_iterator Network::getIteratorToEndInterval(unsigned int neuronId) const
+template<typename State>
+void BasicNetwork<State>::updateRound(unsigned int numberOfSteps)
+{
+	assert(numberOfSteps > 0 and numberOfSteps <= maximalNumberOfStepsPerRound);
+	const unsigned int timeOfFirstStep(neurons.getInternalTime());
+	const size_t numberOfChunks(spikingNeuronsOfChunks.size());
+	workers.runTasks(numberOfChunks, [this, numberOfSteps](size_t, size_t chunk){ updateNeurons(chunk, numberOfSteps); });	//the chunks differ in cost, the ones whose neurons spike much deliver more
+	switch(getDeliveryStrategyOfRound(numberOfSteps))	//the spikes are delivered once all neurons are updated, the ring buffer makes the order incidental
 	{
-		assert(neuronId<neurons.size());
-		return upper_bound(neurons[neuronId]->getSpikeTime().begin(), neurons[neuronId]->getSpikeTime().end(), Simulation::getTimeEndPrintToTxtFile());
+		case DeliveryStrategy::atomic:
+			workers.runTasks(numberOfChunks, [this, timeOfFirstStep, numberOfSteps](size_t, size_t chunk){ deliverSpikesAtomically(chunk, timeOfFirstStep, numberOfSteps); });
+			break;
+		case DeliveryStrategy::privatized:
+			for(vector<uint16_t>& counts: privateSpikeCountsOfWorkers)	//the counts stay cleared from one round to the other, even those of a worker that ran no chunk
+			{
+				if(counts.size() < 2*neurons.size()*numberOfSteps)
+				{
+					counts.resize(2*neurons.size()*numberOfSteps, 0);
+				}
+			}
+			workers.runTasks(numberOfChunks, [this, numberOfSteps](size_t workerId, size_t chunk){ countSpikesPrivately(workerId, chunk, numberOfSteps); });
+			workers.runTasks(numberOfChunks, [this, timeOfFirstStep, numberOfSteps](size_t, size_t chunk){ reducePrivateSpikeCounts(chunk, timeOfFirstStep, numberOfSteps); });
+			break;
+		default:
+			workers.runTasks(numberOfChunks, [this, timeOfFirstStep, numberOfSteps](size_t workerId, size_t chunk){ deliverSpikes(workerId, chunk, timeOfFirstStep, numberOfSteps); });
 	}
+	recordSpikes(timeOfFirstStep, numberOfSteps);
+	neurons.incrementInternalTime(numberOfSteps);
+}
+
+template<typename State>
+void BasicNetwork<State>::updateNeurons(size_t chunk, unsigned int numberOfSteps)
+{
+	vector<unsigned int>& spikingNeurons(spikingNeuronsOfChunks[chunk]);
+	vector<size_t>& firstSpikeOfSteps(firstSpikeOfStepsOfChunks[chunk]);
+	spikingNeurons.clear();
+	firstSpikeOfSteps.clear();
 	
-vector<unsigned int>::const_iterator Network::getIteratorToEnd(unsigned int neuronId) const
+	for(unsigned int step(0); step < numberOfSteps; step++)	//no spike emitted during the round can arrive before its end
 	{
-		assert(neuronId<neurons.size());
-		return neurons[neuronId]->getSpikeTime().end();
+		firstSpikeOfSteps.push_back(spikingNeurons.size());
+		neurons.update(firstNeuronOfChunks[chunk], firstNeuronOfChunks[chunk + 1], neurons.getInternalTime() + step, spikingNeurons);
 	}
-vector<unsigned int>::const_iterator Network::getIteratorToBegin(unsigned int neuronId) const
+	firstSpikeOfSteps.push_back(spikingNeurons.size());
+}
+
+template<typename State>
+typename BasicNetwork<State>::DeliveryStrategy BasicNetwork<State>::getDeliveryStrategyOfRound(unsigned int numberOfSteps) const
+{
+	if(deliveryStrategy != DeliveryStrategy::automatic)
 	{
-		assert(neuronId<neurons.size());
-		return neurons[neuronId]->getSpikeTime().begin();
+		return deliveryStrategy;
 	}
+	size_t numberOfSpikes(0);
+	for(const vector<unsigned int>& spikingNeurons: spikingNeuronsOfChunks)
+	{
+		numberOfSpikes += spikingNeurons.size();
+	}
+	const double numberOfDeliveriesPerNeuronAndStep(double(numberOfSpikes)*connections->getNumberOfConnections()/(double(neurons.size())*neurons.size()*numberOfSteps));	//the reduction reads the counts of every neuron in every step whatever the number of spikes
+	const double sizeOfPrivateSpikeCounts(double(workers.size())*2*neurons.size()*numberOfSteps*sizeof(uint16_t));	//grows with the number of workers, unlike the ring buffers
+	const bool isPrivatizable(sizeOfPrivateSpikeCounts <= MAXIMAL_SIZE_OF_PRIVATE_SPIKE_COUNTS);
+	return (numberOfDeliveriesPerNeuronAndStep >= PRIVATIZED_DELIVERIES_PER_NEURON and isPrivatizable) ? DeliveryStrategy::privatized : DeliveryStrategy::atomic;
+}
 
+template<typename State>
+void BasicNetwork<State>::deliverSpikesAtomically(size_t chunk, unsigned int timeOfFirstStep, unsigned int numberOfSteps)
+{
+	const vector<unsigned int>& spikingNeurons(spikingNeuronsOfChunks[chunk]);
+	const vector<size_t>& firstSpikeOfSteps(firstSpikeOfStepsOfChunks[chunk]);
+	for(unsigned int step(0); step < numberOfSteps; step++)
+	{
+		for(size_t spike(firstSpikeOfSteps[step]); spike < firstSpikeOfSteps[step + 1]; spike++)
+		{
+			const unsigned int spikingNeuron(spikingNeurons[spike]);
+			neurons.receiveSpikeAtomically(connections->beginTargets(spikingNeuron), connections->endTargets(spikingNeuron), timeOfFirstStep + step,
+			                               (spikingNeuron < numberOfExcitatoryNeurons) ? excitatorySpikeAmplitude : inhibitorySpikeAmplitude);
+		}
+	}
+}
 
-
-
-//creation of network
-	
-void Network::createNeurons()
+template<typename State>
+void BasicNetwork<State>::countSpikesPrivately(size_t workerId, size_t chunk, unsigned int numberOfSteps)
 {
-	assert(PERCENT_EXCITATORY_NEURONS >=0);//Beware of negative number of neurons
-	assert(neurons.size()>=NUMBER_OF_EXCITATORY_NEURONS_Ne);
-	assert(neurons.size()==TOTAL_NUMBER_OF_NEURONS_N);
-	
-	for(size_t i(0); i < NUMBER_OF_EXCITATORY_NEURONS_Ne; i++)
+	const vector<unsigned int>& spikingNeurons(spikingNeuronsOfChunks[chunk]);
+	const vector<size_t>& firstSpikeOfSteps(firstSpikeOfStepsOfChunks[chunk]);
+	vector<uint16_t>& counts(privateSpikeCountsOfWorkers[workerId]);	//sized by updateRound
+	for(unsigned int step(0); step < numberOfSteps; step++)
+	{
+		for(size_t spike(firstSpikeOfSteps[step]); spike < firstSpikeOfSteps[step + 1]; spike++)
 		{
-			neurons[i] = new ExcitatoryNeuron;
+			const unsigned int spikingNeuron(spikingNeurons[spike]);
+			uint16_t* const countsOfPopulation(counts.data() + (2*step + ((spikingNeuron < numberOfExcitatoryNeurons) ? 0 : 1))*neurons.size());
+			for(const uint32_t* target(connections->beginTargets(spikingNeuron)); target != connections->endTargets(spikingNeuron); ++target)
+			{
+				countsOfPopulation[*target]++;
+			}
 		}
-		
-		for(size_t i(NUMBER_OF_EXCITATORY_NEURONS_Ne);i < TOTAL_NUMBER_OF_NEURONS_N; i++)
+	}
+}
+
+template<typename State>
+void BasicNetwork<State>::reducePrivateSpikeCounts(size_t chunk, unsigned int timeOfFirstStep, unsigned int numberOfSteps)
+{
+	const size_t firstNeuron(firstNeuronOfChunks[chunk]);
+	const size_t lastNeuron(firstNeuronOfChunks[chunk + 1]);
+	for(unsigned int step(0); step < numberOfSteps; step++)
+	{
+		for(vector<uint16_t>& counts: privateSpikeCountsOfWorkers)	//all sized by updateRound
 		{
-			neurons[i] = new InhibitoryNeuron;
+			uint16_t* const excitatoryCounts(counts.data() + 2*step*neurons.size());
+			uint16_t* const inhibitoryCounts(excitatoryCounts + neurons.size());
+			neurons.receiveSpikeCounts(firstNeuron, lastNeuron, timeOfFirstStep + step, excitatoryCounts, inhibitoryCounts);
+			fill(excitatoryCounts + firstNeuron, excitatoryCounts + lastNeuron, 0);
+			fill(inhibitoryCounts + firstNeuron, inhibitoryCounts + lastNeuron, 0);
 		}
+	}
 }
 
-void Network::establishConnections()
+template<typename State>
+void BasicNetwork<State>::deliverSpikes(size_t workerId, size_t chunk, unsigned int timeOfFirstStep, unsigned int numberOfSteps)
 {
-	default_random_engine randomGenerator;
-	
-	uniform_int_distribution<int> distributionExcitatoryNeurons(0,NUMBER_OF_EXCITATORY_NEURONS_Ne-1);
-	uniform_int_distribution<int> distributionInhibitoryNeurons(NUMBER_OF_EXCITATORY_NEURONS_Ne,TOTAL_NUMBER_OF_NEURONS_N-1);
+	const size_t firstNeuron(firstNeuronOfChunks[chunk]);
+	const size_t lastNeuron(firstNeuronOfChunks[chunk + 1]);
+	const size_t numberOfTiles((lastNeuron - firstNeuron + NUMBER_OF_TARGETS_PER_TILE - 1)/NUMBER_OF_TARGETS_PER_TILE);
+	vector<vector<uint32_t> >& buckets(bucketsOfWorkers[workerId]);
+	buckets.resize(2*numberOfTiles);
 	
-	assert(neurons.size()>=NUMBER_OF_EXCITATORY_NEURONS_Ne);
-	assert(neurons.size()==TOTAL_NUMBER_OF_NEURONS_N);
-	
-		for(const auto& neuron : neurons)
+	for(unsigned int step(0); step < numberOfSteps; step++)	//the spikes of different steps arrive in different ring buffer entries
+	{
+		size_t numberOfSpikes(0);
+		for(const vector<size_t>& firstSpikeOfSteps: firstSpikeOfStepsOfChunks)
+		{
+			numberOfSpikes += firstSpikeOfSteps[step + 1] - firstSpikeOfSteps[step];
+		}
+		const bool isBucketed(isBucketedDeliveryAllowed and numberOfSpikes >= MINIMAL_NUMBER_OF_SPIKES_FOR_BUCKETED_DELIVERY and numberOfTiles > 1);
+		
+		for(size_t spikingChunk(0); spikingChunk < spikingNeuronsOfChunks.size(); spikingChunk++)	//the chunks and the ids in each chunk are in increasing order, thus the excitatory spiking neurons are followed by the inhibitory ones
 		{
-			for(size_t i(0); i < NUMBER_OF_CONNECTIONS_FROM_EXCITATORY_NEURONS_Ce; i++)
+			const vector<unsigned int>::const_iterator firstSpikingNeuron(spikingNeuronsOfChunks[spikingChunk].begin() + firstSpikeOfStepsOfChunks[spikingChunk][step]);
+			const vector<unsigned int>::const_iterator lastSpikingNeuron(spikingNeuronsOfChunks[spikingChunk].begin() + firstSpikeOfStepsOfChunks[spikingChunk][step + 1]);
+			const vector<unsigned int>::const_iterator firstInhibitorySpikingNeuron(lower_bound(firstSpikingNeuron, lastSpikingNeuron, numberOfExcitatoryNeurons));
+			if(isBucketed)
 			{
-				neurons[distributionExcitatoryNeurons(randomGenerator)]->addTarget(neuron);	//Can stimulate itself???
+				sortSpikesIntoBuckets(firstSpikingNeuron, firstInhibitorySpikingNeuron, firstNeuron, lastNeuron, buckets.begin());
+				sortSpikesIntoBuckets(firstInhibitorySpikingNeuron, lastSpikingNeuron, firstNeuron, lastNeuron, buckets.begin() + numberOfTiles);
 			}
-			
-			for(size_t i(0); i < NUMBER_OF_CONNECTIONS_FROM_INHIBITORY_NEURONS_Ci; i++)
+			else
 			{
-				neurons[distributionInhibitoryNeurons(randomGenerator)]->addTarget(neuron);
+				deliverSpikes(firstSpikingNeuron, firstInhibitorySpikingNeuron, timeOfFirstStep + step, excitatorySpikeAmplitude, firstNeuron, lastNeuron);
+				deliverSpikes(firstInhibitorySpikingNeuron, lastSpikingNeuron, timeOfFirstStep + step, inhibitorySpikeAmplitude, firstNeuron, lastNeuron);
 			}
 		}
+		
+		for(size_t tile(0); isBucketed and tile < numberOfTiles; tile++)	//the excitatory spikes arrive before the inhibitory ones, as they do without buckets, so that the sums are exactly the same
+		{
+			vector<uint32_t>& excitatoryBucket(buckets[tile]);
+			vector<uint32_t>& inhibitoryBucket(buckets[numberOfTiles + tile]);
+			neurons.receiveSpike(excitatoryBucket.data(), excitatoryBucket.data() + excitatoryBucket.size(), timeOfFirstStep + step, excitatorySpikeAmplitude);
+			neurons.receiveSpike(inhibitoryBucket.data(), inhibitoryBucket.data() + inhibitoryBucket.size(), timeOfFirstStep + step, inhibitorySpikeAmplitude);
+			excitatoryBucket.clear();	//keeps the memory for the next busy step
+			inhibitoryBucket.clear();
+		}
+	}
 }
 
-void Network::printSimulationData(const std::string& nameOfFile, vector<unsigned int>::const_iterator (Network::*getIteratorBegin)(unsigned int) const , vector<unsigned int>::const_iterator (Network::*getIteratorEnd)(unsigned int) const) const
+template<typename State>
+void BasicNetwork<State>::recordSpikes(unsigned int timeOfFirstStep, unsigned int numberOfSteps)
 {
-	ofstream out(nameOfFile);
-		
-		if(out.fail())
+	for(unsigned int step(0); step < numberOfSteps; step++)
+	{
+		const unsigned int time(timeOfFirstStep + step);
+		unsigned int numberOfSpikes(0);
+		for(const vector<size_t>& firstSpikeOfSteps: firstSpikeOfStepsOfChunks)
 		{
-			cerr << "Error: impossible to write in file " << nameOfFile << endl;//(Too) simplistic solution!
+			numberOfSpikes += firstSpikeOfSteps[step + 1] - firstSpikeOfSteps[step];
 		}
+		numberOfSpikesOfSteps.push_back(numberOfSpikes);
 		
-		else
+		for(const RecordingWindow& window: spikeRecorders)
 		{
-			assert(neurons.size()>=TOTAL_NUMBER_OF_NEURONS_N);//redundancy, I already tested that
-			for(size_t i(0); i < TOTAL_NUMBER_OF_NEURONS_N; i++)
+			if(time < window.beginWindow or time > window.endWindow)	//the bounds are part of the window
 			{
-				
-				if(not neurons[i]->getSpikeTime().empty() )
-				{
-					for(vector<unsigned int>::const_iterator it = (this->*getIteratorBegin)(i) ; it !=(this->*getIteratorEnd)(i); ++it)//could be solved much easier by calling a function in neuron that prints its data into a file and/or treating data after printing it to a text file
-					{
-						out << *it*MIN_TIME_INTERVAL_H << '\t'<< i << '\n' ; //prints the times, not in number of steps, but converted milliseconds
-					}
-				}
+				continue;
 			}
+			for(size_t chunk(0); chunk < spikingNeuronsOfChunks.size(); chunk++)	//the chunks are in increasing order
+			{
+				const unsigned int* const spikingNeurons(spikingNeuronsOfChunks[chunk].data());
+				window.recorder->record(time, spikingNeurons + firstSpikeOfStepsOfChunks[chunk][step], spikingNeurons + firstSpikeOfStepsOfChunks[chunk][step + 1]);
+			}
+		}
+	}
+}
+
+template<typename State>
+void BasicNetwork<State>::deliverSpikes(vector<unsigned int>::const_iterator firstSpikingNeuron, vector<unsigned int>::const_iterator lastSpikingNeuron, unsigned int timeOfSpikes, double spikeAmplitude, unsigned int firstTarget, unsigned int lastTarget)
+{
+	const bool reachesAllTargets(firstTarget == 0 and lastTarget == neurons.size());	//the targets in the range are found by bisection otherwise, the targets of each neuron being sorted
+	
+	for(vector<unsigned int>::const_iterator spikingNeuron(firstSpikingNeuron); spikingNeuron != lastSpikingNeuron; ++spikingNeuron)
+	{
+		const uint32_t* beginTargets(connections->beginTargets(*spikingNeuron));
+		const uint32_t* endTargets(connections->endTargets(*spikingNeuron));
+		if(not reachesAllTargets)
+		{
+			beginTargets = lower_bound(beginTargets, endTargets, firstTarget);
+			endTargets = lower_bound(beginTargets, endTargets, lastTarget);
+		}
+		neurons.receiveSpike(beginTargets, endTargets, timeOfSpikes, spikeAmplitude);
+	}
+}
+
+template<typename State>
+void BasicNetwork<State>::sortSpikesIntoBuckets(vector<unsigned int>::const_iterator firstSpikingNeuron, vector<unsigned int>::const_iterator lastSpikingNeuron, unsigned int firstTarget, unsigned int lastTarget, vector<vector<uint32_t> >::iterator firstBucket)
+{
+	for(vector<unsigned int>::const_iterator spikingNeuron(firstSpikingNeuron); spikingNeuron != lastSpikingNeuron; ++spikingNeuron)
+	{
+		const uint32_t* const endTargets(lower_bound(connections->beginTargets(*spikingNeuron), connections->endTargets(*spikingNeuron), lastTarget));
+		for(const uint32_t* target(lower_bound(connections->beginTargets(*spikingNeuron), endTargets, firstTarget)); target != endTargets; ++target)
+		{
+			firstBucket[(*target - firstTarget)/NUMBER_OF_TARGETS_PER_TILE].push_back(*target);
 		}
-		out.close();
+	}
 }
 
 //testing connectivity
-double Network::getMeanNumberOfTargetsPerNeuron(size_t (Neuron::*getNumberTargets)() const ) const
+template<typename State>
+double BasicNetwork<State>::getMeanNumberOfTargetsPerNeuron(size_t (BasicNetwork::*getNumberTargets)(unsigned int) const ) const
 {
 	double meanNumberOfTargets(0);
-	for(const auto& neuron: neurons)
-	{ meanNumberOfTargets+=(neuron->*getNumberTargets)();}
+	for(size_t i(0); i < neurons.size(); i++)
+	{ meanNumberOfTargets+=(this->*getNumberTargets)(i);}
 	assert(neurons.size()!=0);
 	return meanNumberOfTargets/=neurons.size();
 }
 
+template<typename State>
+size_t BasicNetwork<State>::getNumberOfTargets(unsigned int neuronId) const
+{
+	return connections->getNumberOfTargets(neuronId);
+}
+
+template<typename State>
+size_t BasicNetwork<State>::getNumberOfExcitatoryTargets(unsigned int neuronId) const
+{
+	size_t counterExcitatoryNeurons(0);
+	for(const uint32_t* target(connections->beginTargets(neuronId)); target != connections->endTargets(neuronId); ++target)
+	{
+		if(*target < numberOfExcitatoryNeurons)	//the excitatory neurons come first
+		{
+			counterExcitatoryNeurons++;
+		}
+	}
+	return counterExcitatoryNeurons;
+}
+
+template class BasicNetwork<double>;
+template class BasicNetwork<float>;
+template class BasicNetwork<FixedPointState>;
@@ -1,48 +1,153 @@
 #ifndef NETWORK_H
 #define NETWORK_H
 
+#include "connectivity.hpp"
 #include "parameters.hpp"
-#include "neuron.hpp"
+#include "neuronPopulation.hpp"
+#include "simulationConfig.hpp"
+#include "spikeRecorder.hpp"
+#include "workerPool.hpp"
 
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <vector>
 #include <string>
 #include <fstream>
-#include <array>
 
 /** A network of neurons is what is being simulated.
  * An ensemble of neurons, that evolves over time and reacts to stimuli that arrive from the rest of the brain.
+ * @tparam State the type in which the neurons' potentials and inputs are stored, see BasicNeuronPopulation
  */
-class Network
+template<typename State>
+class BasicNetwork
 {
 	public:
 	
+	/** How the spikes of a round reach their targets.
+	 * With the first strategy, all the spikes are delivered to the targets of one chunk at a time, so that no two threads ever write to the same ring buffer,
+	   but the targets of each chunk have to be looked for in the row of every spiking neuron. With the others, the spikes of the neurons of each chunk are sent to all their targets,
+	   which only works with the integers of counted spikes, see SimulationConfig::isCountingSpikes, whose sums don't depend on the order of the additions. */
+	enum class DeliveryStrategy
+	{
+		byRangeOfTargets, ///< The spikes of all chunks are delivered chunk of targets by chunk of targets, the default.
+		atomic, ///< The spikes of each chunk are delivered with atomic increments of the counts, which pays off when there are few spikes.
+		privatized, ///< Each worker counts the spikes of the chunks it runs in a private copy of the counts of the round, then the copies of all workers are added up chunk by chunk, which pays off when there are many spikes. The copies take 4 bytes per neuron, step of a round and worker, as much as the ring buffers for each worker.
+		automatic ///< Atomic or privatized in each round, depending on the number of spikes to deliver, atomic whenever the private copies would exceed MAXIMAL_SIZE_OF_PRIVATE_SPIKE_COUNTS.
+	};
 
 	/** A constructor.
 	 * Initializes a neuronal network by creating and connecting a number of neurons specified in the parameter file by means of the functions createNeurons() and establishConnections().
 	   There is a defined ratio of inhibitory and exitatory neurons and each one of them receives a fixed number of connections from both inhibitory and excitatory presynaptic neuron that are chosen randomly. */
-	Network();
-
+	BasicNetwork();
+	
+	/** A constructor.
+	 * Initializes a neuronal network as Network() does, whose size, neurons, number of threads and seed are given by a configuration read at runtime.
+	   For a given seed the simulation gives exactly the same results whatever the number of threads.
+	 * @param config the parameters of the network, valid according to SimulationConfig::validate() */
+	explicit BasicNetwork(const SimulationConfig& config);
+	
+	/** A constructor.
+	 * Initializes a neuronal network as Network(const SimulationConfig&) does, but instead of drawing its own connections it shares a table that is never modified,
+	   so that many networks simulated at the same time, for instance the points of a parameter sweep, only hold one copy of the connections.
+	 * @see createConnections
+	 * @throw std::invalid_argument if the table doesn't have as many neurons as the configuration,
+	   or if the spikes of all the presynaptic neurons of a neuron, (C_E + g*C_I)*J, exceed the largest potential of the state, about 32768 J in fixed point
+	 * @param config the parameters of the network, valid according to SimulationConfig::validate()
+	 * @param connections a table of connections, frozen */
+	BasicNetwork(const SimulationConfig& config, std::shared_ptr<const Connectivity> connections);
 	
-	/// A destructor which deletes all neurons of the network.
-	~Network();
+	/** Draws the random connections of a network described by a configuration, which only depend on its size, its number of connections per neuron and the seed of the connections.
+	 * The connections are drawn twice from the same random sequences, first to count the targets of each neuron, then to store them in the table.
+	   The postsynaptic neurons are split in blocks whose presynaptic neurons are drawn from a generator of their own, so that the threads of the configuration can share the blocks
+	   and the table is the same whatever their number.
+	 * @param config the parameters of the network
+	 * @return a frozen table that networks can share */
+	static std::shared_ptr<const Connectivity> createConnections(const SimulationConfig& config);
 	
-	/// A method updating all of the network's neuron by one step which is used in the main loop.
+	/** A constructor.
+	 * Initializes a neuronal network as Network() does, whose update is shared by a number of threads and whose background noise only depends on a seed.
+	 * @param numberOfThreads a size_t, zero stands for as many as the hardware supports
+	 * @param seed an unsigned int, zero stands for a random one */
+	BasicNetwork(size_t numberOfThreads, unsigned int seed);
+	
+	/** A method updating all of the network's neuron by one step and delivering the spikes that occurred to their targets, which is used in the main loop.
+	 * Each thread first updates its own range of neurons and collects the ones that spiked, then, once all are done, delivers all the spikes to the targets in its own range.
+	   No thread ever writes to another thread's neurons and each ring buffer receives the spikes in the order of the ids of the spiking neurons, whatever the number of threads. */
 	void update();
 	
+	/** A method updating all of the network's neurons by a number of steps.
+	 * If the communication is batched, each thread advances its neurons by as many steps as the signal delay before the spikes are exchanged, 
+	   which is licit because no spike can arrive sooner. This reduces the number of times the threads have to wait for each other by the signal delay. 
+	   The results are exactly the same as when the network is updated step by step.
+	 * @see Simulation::run()
+	 * @see setBatchedCommunication
+	 * @param numberOfSteps an unsigned int */
+	void update(unsigned int numberOfSteps);
+	
+	/** A setter that allows to deliver the spikes of busy steps through buckets or to always deliver them directly, which is the default. The results are exactly the same.
+	 * The buckets only pay off when the ring buffers of a chunk are much larger than the last level cache.
+	 * @see deliverSpikes(size_t workerId, size_t chunk, unsigned int timeOfFirstStep, unsigned int numberOfSteps)
+	 * @param isAllowed a bool */
+	void setBucketedDelivery(bool isAllowed);
+	
+	/** A setter that allows to choose between exchanging the spikes after each step or only after as many steps as the signal delay, which is the default.
+	 * @param isBatched a bool */
+	void setBatchedCommunication(bool isBatched);
+	
+	/** A setter for the way the spikes reach their targets. The results are exactly the same whatever the strategy.
+	 * The privatized strategy allocates 4 bytes per neuron, step of a round and worker once it is used, the automatic one only if they stay below MAXIMAL_SIZE_OF_PRIVATE_SPIKE_COUNTS.
+	 * @throw std::invalid_argument if the strategy isn't byRangeOfTargets and the spikes aren't counted
+	 * @param strategy a DeliveryStrategy */
+	void setDeliveryStrategy(DeliveryStrategy strategy);
+	
+	/** Adds a recorder that receives the spikes occurring within a window while the network is being simulated.
+	 * The neurons themselves only keep the time of their latest spike, the recorders are the only way to fetch the spikes, which keeps the memory of the network constant however long the simulation.
+	   The spikes are handed over after each round, step after step and in the order of the neurons' ids within a step.
+	 * @param recorder a pointer to a recorder that stays alive until it is removed or the network is destroyed, the network doesn't own it
+	 * @param beginWindow the first step whose spikes are recorded, an unsigned int
+	 * @param endWindow the last step whose spikes are recorded, an unsigned int, by default the end of the simulation */
+	void addSpikeRecorder(SpikeRecorder* recorder, unsigned int beginWindow = 0, unsigned int endWindow = std::numeric_limits<unsigned int>::max());
+	
+	/** Stops handing the spikes over to a recorder.
+	 * @param recorder a pointer to a recorder added before */
+	void removeSpikeRecorder(SpikeRecorder* recorder);
+	
+	/** A getter for the parameters the network was created with.
+	 * The ratios set later on by setRatioJinoverJexG and setRatioVextOverVthr are not reflected.
+	 * @return a const reference to the configuration */
+	const SimulationConfig& getConfig() const;
+	
+	/** A getter for the network's clock.
+	 * @return the number of steps the network has been updated, an unsigned int */
+	unsigned int getInternalTime() const;
+	
+	/** A getter for the number of threads sharing the update.
+	 * @return a size_t */
+	size_t getNumberOfThreads() const;
+	
+	/** A getter for the membrane potential of one of the network's neurons.
+	 * @param neuronId an unsigned int
+	 * @return the neuron's membrane potential, a double */
+	double getMembranePotential(unsigned int neuronId) const;
+	
+	/** A getter for the table of connections, which other networks of the same size may share.
+	 * @return a shared pointer to the table */
+	std::shared_ptr<const Connectivity> getConnections() const;
+	
+	//simulation parameters
+	/**Sets the ratio of the spike amplitudes of inhibitory and excitatory neurons, which defines the inhibitory neurons' spike amplitude.
+	 * @see Simulation::printDataForBrunelFigureToFile
+	 * @param ratioJinoverJexG a double */
+	void setRatioJinoverJexG(double ratioJinoverJexG);
 	
-	//print data
-	/**Prints each neuron's spike times and neuron id in a file of given name using the private function print simulation data.
-	 * @param nameOfFile a string*/
-	void printSimulationData(const std::string& nameOfFile) const;
-	/**Prints each neuron's spike times that lie in an interval defined by the simulation and neuron id in a file of given name using the private function print simulation data.
-	 * @see Simulation::printDataForBrunelFigureToFile()
-	 * @param nameOfFile a string*/
-	void printSimulationDataWithinTimeInterval(const std::string& nameOfFile) const;
+	/**Sets the frequency of the background noise arriving from the rest of the brain.
+	 * @see Simulation::printDataForBrunelFigureToFile
+	 * @param ratioVextOverVthr a double */
+	void setRatioVextOverVthr(double ratioVextOverVthr);
 	
-	//void printSimulationDataWithinTimeInterval(const std::string& nameOfFile, unsigned int beginInterval, unsigned int endInterval) const; // Would be nice to have but is nasty to program with my class architecture
-		
-	/**Calculates the mean spike rate of the network's neurons in an interval to indicate.
+	
+	/**Calculates the mean spike rate of the network's neurons in an interval to indicate, from the number of spikes of each step, which is the only history the network keeps.
 	 * @see Simulation::getMeanSpikeRateInInterval
 	 * @see Simulation::printDataForBrunelFigureToFileWithMeanSpikingRate
 	 * @param beginInterval to investigate in steps an unsigned int
@@ -57,53 +162,146 @@ class Network
 	double getMeanNumberOfExcitatoryTargetsPerNeuron() const;
 	
 	private:
-	std::array<Neuron*, TOTAL_NUMBER_OF_NEURONS_N> neurons; ///< A container carrying the neurons forming the network, an array of pointers to neurons.
+	SimulationConfig config; ///< The parameters the network was created with.
+	unsigned int numberOfExcitatoryNeurons; ///< The number of excitatory neurons, which come first, Ne.
+	BasicNeuronPopulation<State> neurons; ///< The state of the neurons forming the network, stored field by field. The excitatory neurons come first, followed by the inhibitory ones.
+	double excitatorySpikeAmplitude; ///< The spike amplitude shared by all the excitatory neurons, a double.
+	double inhibitorySpikeAmplitude; ///< The spike amplitude shared by all the inhibitory neurons, a double.
+	std::shared_ptr<const Connectivity> connections; ///< The ids of the postsynaptic neurons of each neuron, the neurons on which an eventual spike has an impact. Never modified, hence safely shared with other networks.
+	
+	WorkerPool workers; ///< The threads sharing the update of the network.
+	std::vector<size_t> firstNeuronOfChunks; ///< The id of the first neuron of each chunk, the ranges of whole blocks the workers take in turn, with one more entry marking the end of the network.
+	std::vector<std::vector<unsigned int> > spikingNeuronsOfChunks; ///< The ids of the neurons of each chunk that spiked in the current round, step after step, reused from one round to the other.
+	std::vector<std::vector<size_t> > firstSpikeOfStepsOfChunks; ///< For each chunk, the position in spikingNeuronsOfChunks of the first spike of each step of the current round, with one more entry marking the end.
+	/// A recorder and the steps whose spikes it receives.
+	struct RecordingWindow
+	{
+		SpikeRecorder* recorder; ///< The recorder, not owned by the network.
+		unsigned int beginWindow; ///< The first step whose spikes are recorded.
+		unsigned int endWindow; ///< The last step whose spikes are recorded.
+	};
+	std::vector<RecordingWindow> spikeRecorders; ///< The recorders receiving the spikes of each round.
+	std::vector<std::vector<std::vector<std::uint32_t> > > bucketsOfWorkers; ///< For each worker, the targets of the spikes of a busy step, one bucket per tile of the chunk it delivers to for the excitatory spikes followed by one per tile for the inhibitory ones.
+	std::vector<unsigned int> numberOfSpikesOfSteps; ///< The number of neurons that spiked in each step, four bytes per step whatever the size of the network.
+	unsigned int maximalNumberOfStepsPerRound; ///< The number of steps the neurons advance between two exchanges of spikes, the signal delay if the communication is batched and one otherwise.
+	bool isBucketedDeliveryAllowed; ///< True if the spikes of busy steps are delivered through buckets, false, the default, if they are always delivered directly.
+	DeliveryStrategy deliveryStrategy; ///< The way the spikes reach their targets.
+	std::vector<std::vector<std::uint16_t> > privateSpikeCountsOfWorkers; ///< For each worker and each step of a round, the number of excitatory spikes the neurons of its chunks sent to each neuron followed by the number of inhibitory ones, if the delivery is privatized.
 	
 	//creation of network
-	/**Auxiliary function that creates a number of neurons defined the parameter file.
-	 * @see Neuron()*/
+	/**Auxiliary function that sets the spike amplitudes of the excitatory and the inhibitory neurons, whose numbers are defined by the configuration.
+	 * @see setRatioJinoverJexG */
 	void createNeurons();
-	/**Auxiliary function that creates the connections between neurons.
-	  *@see Neuron()*/
-	void establishConnections();
-	
-	//fetch data
-	
-	/**An auxiliary function for printing the network's spike times to a file that allows to avoid the duplication of code.
-	 * @see printSimulationData(const std::string& nameOfFile)
-	 * @see printSimulationDataWithinTimeInterval
-	 * @param nameOfFile a string
-	 * @param getIteratorBegin a member function that yields an iterator on a vector<unsigned int> pointing the first element that is printed
-	 * @param getIteratorEnd a member function that yields an iterator on a vector<unsigned int> pointing the last element that is printed */
-	void printSimulationData(const std::string& nameOfFile, std::vector<unsigned int>::const_iterator (Network::*getIteratorBegin)(unsigned int) const , std::vector<unsigned int>::const_iterator (Network::*getIteratorEnd)(unsigned int) const ) const;
-	
-	/**An auxiliary function for printing the network's spike times to a file that returns an iterator pointing on neuron of given id's first spike time.
-	 * @see printSimulationData(const std::string& nameOfFile)
-	 * @param neuronId an unsigned int */
-	std::vector<unsigned int>::const_iterator getIteratorToBegin(unsigned int neuronId) const;
-	
-	/**An auxiliary function for printing the network's spike times to a file that returns an iterator pointing on neuron of given id's last spike time.
-	 * @see printSimulationData(const std::string& nameOfFile)
-	 * @param neuronId an unsigned int */
-	std::vector<unsigned int>::const_iterator getIteratorToEnd(unsigned int neuronId) const;
-	
-	/**An auxiliary function for printing the network's spike times to a file that returns an iterator pointing on neuron of given id's first spike time that lies within an interval defined in the parameter file.
-	 * @see printSimulationDataWithinTimeInterval(const std::string& nameOfFile)
-	 * @param neuronId an unsigned int */
-	std::vector<unsigned int>::const_iterator getIteratorToBeginInterval(unsigned int neuronId) const;
-	
-	/**An auxiliary function for printing the network's spike times to a file that returns an iterator pointing on neuron of given id's last spike time that lies within an interval defined in the parameter file.
-	 * @see printSimulationDataWithinTimeInterval(const std::string& nameOfFile)
-	 * @param neuronId an unsigned int */
-	std::vector<unsigned int>::const_iterator getIteratorToEndInterval(unsigned int neuronId) const;
+	static constexpr size_t NUMBER_OF_TARGETS_PER_BLOCK = 256; ///< The number of postsynaptic neurons whose connections are drawn from the same generator.
+	
+	/**Auxiliary function that draws the random connections towards a range of blocks of neurons and passes each one of them to a method of the connectivity table, which allows to avoid the duplication of code.
+	  *@see createConnections()
+	  *@param config the parameters of the network
+	  *@param connections the table being built
+	  *@param connect a member function of Connectivity taking the ids of the presynaptic and of the postsynaptic neuron and the part
+	  *@param part the part of the table the range belongs to, a size_t
+	  *@param firstBlock the first block of postsynaptic neurons, a size_t
+	  *@param lastBlock the block past the last one, a size_t */
+	static void establishConnections(const SimulationConfig& config, Connectivity& connections, void (Connectivity::*connect)(unsigned int, unsigned int, size_t), size_t part, size_t firstBlock, size_t lastBlock);
+	
+	//update
+	static constexpr size_t NUMBER_OF_CHUNKS_PER_WORKER = 4; ///< The number of chunks the neurons are split into per worker if there are several, so that the workers that are done early can take over chunks of the others.
+	
+	/**Auxiliary function that performs a round, in which the neurons advance by a number of steps, followed by the exchange of the spikes that occurred.
+	 * @see update()
+	 * @see update(unsigned int numberOfSteps)
+	 * @param numberOfSteps an unsigned int, at most the signal delay */
+	void updateRound(unsigned int numberOfSteps);
+	
+	/**Auxiliary function that updates the neurons of a chunk by a number of steps and collects the ones that spiked in each step.
+	 * @see updateRound
+	 * @param chunk a size_t
+	 * @param numberOfSteps an unsigned int */
+	void updateNeurons(size_t chunk, unsigned int numberOfSteps);
+	
+	static constexpr double PRIVATIZED_DELIVERIES_PER_NEURON = 0.5; ///< The number of spikes per neuron and step from which on the privatized delivery beats the atomic one, according to deliveryBenchmark.
+	static constexpr size_t MAXIMAL_SIZE_OF_PRIVATE_SPIKE_COUNTS = 256*1024*1024; ///< The size in bytes the private counts of all workers may take when the strategy is automatic, 256 MiB, enough for 12500 neurons, the signal delay of the parameter file and 300 workers.
+	
+	/**Auxiliary function that chooses the strategy of a round if it is automatic, from the number of spikes to deliver and the memory the private counts would take.
+	 * @see DeliveryStrategy
+	 * @param numberOfSteps the number of steps of the round, an unsigned int
+	 * @return atomic or privatized if the strategy is automatic, the strategy set otherwise */
+	DeliveryStrategy getDeliveryStrategyOfRound(unsigned int numberOfSteps) const;
+	
+	/**Auxiliary function that delivers the spikes of the neurons of one chunk that occurred during a round to all their targets, with atomic increments.
+	 * @see DeliveryStrategy
+	 * @param chunk a size_t
+	 * @param timeOfFirstStep the time of the round's first step, an unsigned int
+	 * @param numberOfSteps an unsigned int */
+	void deliverSpikesAtomically(size_t chunk, unsigned int timeOfFirstStep, unsigned int numberOfSteps);
+	
+	/**Auxiliary function that counts the spikes of the neurons of one chunk that occurred during a round in the private counts of the worker running it.
+	 * @see DeliveryStrategy
+	 * @param workerId a size_t
+	 * @param chunk a size_t
+	 * @param numberOfSteps an unsigned int */
+	void countSpikesPrivately(size_t workerId, size_t chunk, unsigned int numberOfSteps);
+	
+	/**Auxiliary function that adds up the private counts of all workers for the neurons of one chunk, hands them over to the neurons and clears them.
+	 * @see DeliveryStrategy
+	 * @param chunk a size_t
+	 * @param timeOfFirstStep the time of the round's first step, an unsigned int
+	 * @param numberOfSteps an unsigned int */
+	void reducePrivateSpikeCounts(size_t chunk, unsigned int timeOfFirstStep, unsigned int numberOfSteps);
+	
+	static constexpr size_t NUMBER_OF_TARGETS_PER_TILE = 2048; ///< The number of neurons whose spikes are gathered in the same bucket, their ring buffers take 256 kB for the signal delay of the parameter file.
+	static constexpr size_t MINIMAL_NUMBER_OF_SPIKES_FOR_BUCKETED_DELIVERY = 256; ///< The number of spikes in a step from which on they are sorted into buckets before being delivered.
+	
+	/**Auxiliary function that delivers the spikes of all chunks that occurred during a round to the targets in one chunk.
+	 * In a step with many spikes, as in the synchronous regimes, the targets are first sorted into buckets of neurons whose ring buffers fit into the cache, 
+	   reading each row of targets only once, then the buckets are delivered one after the other. Otherwise the scattered writes of all the spikes would sweep over the ring buffers of the whole chunk again and again.
+	 * @see updateRound
+	 * @param workerId the worker running the delivery, whose buckets are used, a size_t
+	 * @param chunk a size_t
+	 * @param timeOfFirstStep the time of the round's first step, an unsigned int
+	 * @param numberOfSteps an unsigned int */
+	void deliverSpikes(size_t workerId, size_t chunk, unsigned int timeOfFirstStep, unsigned int numberOfSteps);
+	
+	/**Auxiliary function that counts the spikes of all chunks that occurred during a round and hands them over to the recorders whose window contains their step.
+	 * @see updateRound
+	 * @param timeOfFirstStep the time of the round's first step, an unsigned int
+	 * @param numberOfSteps an unsigned int */
+	void recordSpikes(unsigned int timeOfFirstStep, unsigned int numberOfSteps);
+	
+	/**Auxiliary function that sends the spikes of neurons belonging to the same population to those of their targets that lie in a range of neurons.
+	 * @see deliverSpikes(size_t workerId, size_t chunk, unsigned int timeOfFirstStep, unsigned int numberOfSteps)
+	 * @param firstSpikingNeuron an iterator on the id of the first spiking neuron
+	 * @param lastSpikingNeuron an iterator past the id of the last spiking neuron
+	 * @param timeOfSpikes the time at which the neurons spiked, an unsigned int
+	 * @param spikeAmplitude the spike amplitude of the population, a double
+	 * @param firstTarget the id of the first neuron that receives the spikes, an unsigned int
+	 * @param lastTarget the id past the last neuron that receives the spikes, an unsigned int */
+	void deliverSpikes(std::vector<unsigned int>::const_iterator firstSpikingNeuron, std::vector<unsigned int>::const_iterator lastSpikingNeuron, unsigned int timeOfSpikes, double spikeAmplitude, unsigned int firstTarget, unsigned int lastTarget);
+	
+	/**Auxiliary function that sorts those targets of spiking neurons that lie in a range of neurons into one bucket per tile of NUMBER_OF_TARGETS_PER_TILE neurons, keeping the order of the spikes in each bucket.
+	 * @see deliverSpikes(size_t workerId, size_t chunk, unsigned int timeOfFirstStep, unsigned int numberOfSteps)
+	 * @param firstSpikingNeuron an iterator on the id of the first spiking neuron
+	 * @param lastSpikingNeuron an iterator past the id of the last spiking neuron
+	 * @param firstTarget the id of the first neuron of the range, an unsigned int
+	 * @param lastTarget the id past the last neuron of the range, an unsigned int
+	 * @param firstBucket an iterator on the bucket of the range's first tile */
+	void sortSpikesIntoBuckets(std::vector<unsigned int>::const_iterator firstSpikingNeuron, std::vector<unsigned int>::const_iterator lastSpikingNeuron, unsigned int firstTarget, unsigned int lastTarget, std::vector<std::vector<std::uint32_t> >::iterator firstBucket);
 	
 	//testing connectivity
 	/**Auxiliary function .
 	  *@see getMeanNumberOfTargetsPerNeuron()
 	  *@see getMeanNumberOfExcitatoryTargetsPerNeuron()
-	  *@param getNumberTargets a member function of neuron that yields an unsigned int */
-	double getMeanNumberOfTargetsPerNeuron(size_t (Neuron::*getNumberTargets)() const ) const;
+	  *@param getNumberTargets a member function that yields the number of (some) targets of the neuron of given id, a size_t */
+	double getMeanNumberOfTargetsPerNeuron(size_t (BasicNetwork::*getNumberTargets)(unsigned int) const ) const;
+	
+	/**A getter of the number of targets a neuron has.
+	  *@param neuronId an unsigned int */
+	size_t getNumberOfTargets(unsigned int neuronId) const;
+	/**A getter of the number of excitatory neurons among the targets a neuron has.
+	  *@param neuronId an unsigned int */
+	size_t getNumberOfExcitatoryTargets(unsigned int neuronId) const;
 };
 
+typedef BasicNetwork<double> Network; ///< The reference network, whose neurons' state is stored in double precision.
 
 #endif
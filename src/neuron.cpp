@@ -1,3 +1,4 @@
+#include "counterBasedGenerator.hpp"
 #include "neuron.hpp"
 #include "parameters.hpp"
 
@@ -16,10 +17,13 @@ using namespace std;
 
 double Neuron::ratioVextOverVthr(RATIO_V_EXTERNAL_OVER_V_THRESHOLD);
 
-	Neuron::Neuron()
+	Neuron::Neuron(unsigned int id, unsigned int seed)
 	:membranePotential(INITIAL_MEMBRANE_POTENTIAL)
 	,inputCurrent(EXTERNAL_CURRENT_BY_DEFAULT)
 	,internalTime(INITIAL_TIME) 
+	,id(id)
+	,seed(seed)
+	,hasUndeliveredSpike(false)
 	{ for (auto& element: incomingSpikes){element =0;} }	//Initializes the ring buffer entries to zero
 		
 	Neuron:: ~Neuron(){}
@@ -75,6 +79,20 @@ double Neuron::ratioVextOverVthr(RATIO_V_EXTERNAL_OVER_V_THRESHOLD);
 		
 	
 
+	void Neuron::deliverSpike()
+	{
+		if(not hasUndeliveredSpike)
+		{
+			return;
+		}
+		hasUndeliveredSpike = false;
+		const double spikeAmplitude(getSpikeAmplitude()); //two types of neurons have to be considered, the amplitude is the same for all targets
+		for(auto& targetNeuron: targets)
+		{
+			targetNeuron->receiveSpike(spikes.back(), spikeAmplitude);	//the time of the spike, the neuron's clock has moved on since
+		}
+	}
+
 	void Neuron:: addTarget(Neuron* target)	
 	{
 		if(target != nullptr) {
@@ -85,10 +103,14 @@ double Neuron::ratioVextOverVthr(RATIO_V_EXTERNAL_OVER_V_THRESHOLD);
 	//Random Generator
 	double Neuron::getBackgroundNoise() const
 	{
-		 static random_device randomDevice;
-		 static mt19937 generator(randomDevice());
-		 static poisson_distribution<> distribution(ratioVextOverVthr*MEMBRANE_POTENTIAL_THRESHOLD*MIN_TIME_INTERVAL_H/(SPIKE_AMPLITUDE_J_EXCITATORY_NEURON*TIME_CONSTANT_TAU));//V_EXT*J_EXT*h*Cext, "The number of connections from outside the network is taken to be equal to the number of recurrent excitatory ones, Cext = Ce"
-		 return SPIKE_AMPLITUDE_J_EXCITATORY_NEURON*distribution(generator);
+		 const double meanNumberOfExternalSpikes(ratioVextOverVthr*MEMBRANE_POTENTIAL_THRESHOLD*MIN_TIME_INTERVAL_H/(SPIKE_AMPLITUDE_J_EXCITATORY_NEURON*TIME_CONSTANT_TAU));//V_EXT*J_EXT*h*Cext, "The number of connections from outside the network is taken to be equal to the number of recurrent excitatory ones, Cext = Ce"
+		 if(backgroundNoiseDistribution.mean() != meanNumberOfExternalSpikes)	//the ratio is shared by all neurons and may have changed since the last step
+		 {
+			 backgroundNoiseDistribution.param(poisson_distribution<>::param_type(meanNumberOfExternalSpikes));
+		 }
+		 backgroundNoiseDistribution.reset();	//the draw only depends on the generator, not on the previous ones
+		 CounterBasedGenerator generator(seed, id, internalTime);	//the neuron's own sequence of random numbers, nothing is shared with other neurons
+		 return SPIKE_AMPLITUDE_J_EXCITATORY_NEURON*backgroundNoiseDistribution(generator);
 	}
 	
 	void Neuron::setRatioVextOverVthr(double ratioVextOverVthr_)
@@ -119,19 +141,11 @@ double Neuron::ratioVextOverVthr(RATIO_V_EXTERNAL_OVER_V_THRESHOLD);
 		return not(spikes.empty() or ((internalTime - spikes.back())>=	REFRACTION_PERIOD));
 	}
 	
-	void Neuron::spike()	//stores the spiking time, sets the membrane potential to sends a signal to the connected neurons
+	void Neuron::spike()	//stores the spiking time and sets the membrane potential, the signal to the connected neurons is sent by deliverSpike()
 	{
 		spikes.push_back(internalTime);
 		membranePotential = RESET_MEMBRANE_POTENTIAL;
-		if(not targets.empty())
-		{
-			for(auto& targetNeuron: targets)
-			{
-				if(targetNeuron != nullptr) {
-                targetNeuron->receiveSpike(internalTime, getSpikeAmplitude()); //two types of neurons have to be considered
-				}
-			}
-		}
+		hasUndeliveredSpike = true;
 	}
 		
 		
@@ -4,6 +4,7 @@
 #include "parameters.hpp"
 
 #include <array>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -14,8 +15,10 @@ class Neuron
 	public:
 	
 	//constructor and deconstructor
-	/// A constructor.
-	Neuron();
+	/** A constructor.
+	 * @param id the neuron's id, which identifies its background noise together with the seed, an unsigned int
+	 * @param seed the seed of the background noise, an unsigned int */
+	explicit Neuron(unsigned int id = 0, unsigned int seed = NOISE_SEED_BY_DEFAULT);
 	/// A destructor.
 	virtual ~Neuron();	//has to be virtual, since otherwise the object might not get properly destroyed
 	
@@ -78,6 +81,13 @@ class Neuron
 	 * @return if the neuron is in a refractory state, a bool	*/ 
 	void receiveSpike(unsigned int localTimeOfSpikingNeuron, double spikeAmplitude);
 	
+	/**Second phase of a step, sends the spike the neuron emitted in the step it has just performed, if any, to the connected neurons.
+	 * The update itself only records the spike, so that all the neurons can be updated before any spike is delivered, as Network::update() does with whole ranges of neurons.
+	   Calling it more than once after a step or for a step without spike has no effect.
+	 * @see update()
+	 * @see receiveSpike() */
+	void deliverSpike();
+	
 	
 	
 	//Network
@@ -89,6 +99,8 @@ class Neuron
 	
 		//Random Generator
 	/** Creates a value which accounts for the contribution of the rest of the brain. This contribution is modeled by Cext excitatory neurons that fire randomly according to a poisson distribution at a frequency vext.
+	 * The random numbers come from a counter-based generator keyed by the seed, the neuron's id and its internal time, thus the noise only depends on these three numbers,
+	   neurons don't share any state and can be used from different threads. Calling it twice in the same step gives the same value.
 	 * @see updateMembranePotential()
 	 * @return a randomly generated  value representing the background noise coming from the rest of the brain, a double	*/
 	double getBackgroundNoise() const;
@@ -113,6 +125,11 @@ class Neuron
 	
 	static double ratioVextOverVthr;///< A value determining the frequency of spikes from the rest of the brain.
 	
+	unsigned int id; ///< Together with the seed and the internal time identifies the random numbers of the background noise, an unsigned int.
+	unsigned int seed; ///< The seed of the neuron's random numbers, an unsigned int.
+	mutable std::poisson_distribution<> backgroundNoiseDistribution; ///< The number of external spikes in a step, whose mean follows ratioVextOverVthr.
+	bool hasUndeliveredSpike; ///< True between a spike and its delivery to the targets.
+	
 	
 	//update and related functions
 	///An auxiliary function that allows to avoid duplication of code in update() and updateWithoutBackgroundNoise().
@@ -133,7 +150,7 @@ class Neuron
 	 * @return if the neuron is in a refractory state, a bool	*/
 	bool isRefractory() const;
 	
-	/**Stores the spiking time and sets the membrane potential to zero and sends an electrical impulse to the connected neurons.
+	/**Stores the spiking time and sets the membrane potential to zero, the electrical impulse is sent to the connected neurons by deliverSpike().
 	 * @see update(void (Neuron::*membranePotentialUpdate)())	*/ 
 	void spike();
 
@@ -0,0 +1,541 @@
+#include "counterBasedGenerator.hpp"
+#include "neuronPopulation.hpp"
+#include "parameters.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+template<typename State>
+constexpr size_t BasicNeuronPopulation<State>::BLOCK_SIZE;
+
+template<typename State>
+BasicNeuronPopulation<State>::BasicNeuronPopulation(size_t numberOfNeurons)
+:BasicNeuronPopulation(numberOfNeurons, random_device()())
+{}
+
+template<typename State>
+BasicNeuronPopulation<State>::BasicNeuronPopulation(size_t numberOfNeurons, unsigned int seed, const SimulationConfig& config)
+:representation(config.spikeAmplitudeJExcitatory)
+,signalDelay(config.signalDelayD)
+,ringBufferSize(config.signalDelayD + 1)
+,decayPerStep(config.getDecayOfMembranePotential())
+,decayOfMembranePotential(StateRepresentation<State>::toFactor(decayPerStep))
+,membranePotentialThreshold(representation.fromMillivolts(config.membranePotentialThreshold))
+,resetMembranePotential(representation.fromMillivolts(config.resetMembranePotential))
+,refractoryCounterAfterSpike((config.refractionPeriod > 0) ? config.refractionPeriod - 1 : 0)	//the neuron is refractory during the refractionPeriod-1 steps that follow the spike, see Neuron::isRefractory()
+,spikeAmplitudeOfBackgroundNoise(representation.fromMillivolts(config.spikeAmplitudeJExcitatory))
+,meanNumberOfExternalSpikesPerRatio(config.getMeanNumberOfExternalSpikes(1))
+,membranePotentials(numberOfNeurons, representation.fromMillivolts(config.initialMembranePotential))
+,lastSpikeTimes(numberOfNeurons, INITIAL_TIME)
+,refractoryCounters(numberOfNeurons, 0)
+,slotSize((numberOfNeurons + BLOCK_SIZE - 1)/BLOCK_SIZE*BLOCK_SIZE)
+,countsSpikes(config.isCountingSpikes)
+,incomingSpikes(slotSize*(countsSpikes ? 1 : ringBufferSize), 0)
+,spikeCounts(countsSpikes ? 2*slotSize*ringBufferSize : 0, 0)
+,excitatorySpikeAmplitude(config.spikeAmplitudeJExcitatory)
+,inhibitorySpikeAmplitude(-(config.spikeAmplitudeJExcitatory*config.ratioJinOverJexG))
+,internalTime(INITIAL_TIME)
+,seed(seed)
+,backgroundNoise(0)
+,hasBackgroundNoise(false)
+,randomNumbers(numberOfNeurons, 0)
+,eventDriven(config.isEventDriven)
+,lastUpdateTimes(eventDriven ? numberOfNeurons : 0, INITIAL_TIME)
+,decayOverSteps()
+,numberOfWordsPerSlot((numberOfNeurons + 63)/64)
+,pendingNeurons(eventDriven ? numberOfWordsPerSlot*ringBufferSize : 0, 0)
+{
+	setRatioVextOverVthr(config.ratioVextOverVthr);
+	
+	if(eventDriven)
+	{
+		const size_t MAXIMAL_NUMBER_OF_TABULATED_STEPS(1024);	//longer silences are rare, their decay is computed with pow()
+		double decay(1);
+		while(decayOverSteps.size() <= MAXIMAL_NUMBER_OF_TABULATED_STEPS)
+		{
+			decayOverSteps.push_back(StateRepresentation<State>::toFactor(decay));
+			decay *= decayPerStep;	//the same rounding as the step by step decay in double precision for short silences
+		}
+		for(size_t i(0); i < numberOfNeurons; i++)	//the initial membrane potential may already be above the threshold
+		{
+			flag(i, internalTime%ringBufferSize);
+		}
+	}
+}
+
+template<typename State>
+size_t BasicNeuronPopulation<State>::size() const
+{ return membranePotentials.size(); }
+
+template<typename State>
+unsigned int BasicNeuronPopulation<State>::getInternalTime() const
+{ return internalTime; }
+
+template<typename State>
+unsigned int BasicNeuronPopulation<State>::getSignalDelay() const
+{ return signalDelay; }
+
+template<typename State>
+double BasicNeuronPopulation<State>::getMembranePotential(unsigned int neuronId) const
+{
+	assert(neuronId < size());
+	if(eventDriven and internalTime > lastUpdateTimes[neuronId])
+	{
+		return representation.toMillivolts(StateRepresentation<State>::multiply(membranePotentials[neuronId], getDecayOverSteps(internalTime - lastUpdateTimes[neuronId])));
+	}
+	return representation.toMillivolts(membranePotentials[neuronId]);
+}
+
+template<typename State>
+unsigned int BasicNeuronPopulation<State>::getLastSpikeTime(unsigned int neuronId) const
+{
+	assert(neuronId < size());
+	return lastSpikeTimes[neuronId];
+}
+
+template<typename State>
+bool BasicNeuronPopulation<State>::isEventDriven() const
+{ return eventDriven; }
+
+template<typename State>
+bool BasicNeuronPopulation<State>::isCountingSpikes() const
+{ return countsSpikes; }
+
+template<typename State>
+void BasicNeuronPopulation<State>::setSpikeAmplitudes(double excitatorySpikeAmplitude, double inhibitorySpikeAmplitude)
+{
+	this->excitatorySpikeAmplitude = excitatorySpikeAmplitude;
+	this->inhibitorySpikeAmplitude = inhibitorySpikeAmplitude;
+}
+
+template<typename State>
+void BasicNeuronPopulation<State>::setRatioVextOverVthr(double ratioVextOverVthr)
+{
+	const double meanNumberOfExternalSpikes(ratioVextOverVthr*meanNumberOfExternalSpikesPerRatio);
+	hasBackgroundNoise = (meanNumberOfExternalSpikes > 0);
+	backgroundNoise = PoissonSampler(max(meanNumberOfExternalSpikes, 0.0));
+}
+
+template<typename State>
+void BasicNeuronPopulation<State>::update(vector<unsigned int>& spikingNeurons)
+{
+	update(0, size(), internalTime, spikingNeurons);
+	incrementInternalTime();
+}
+
+template<typename State>
+void BasicNeuronPopulation<State>::update(size_t firstNeuron, size_t lastNeuron, unsigned int time, vector<unsigned int>& spikingNeurons)
+{
+	assert(firstNeuron%BLOCK_SIZE == 0 and (lastNeuron%BLOCK_SIZE == 0 or lastNeuron == size()));
+	assert(time >= internalTime and time < internalTime + max(signalDelay, 1u));
+	const size_t firstNewSpike(spikingNeurons.size());
+	if(eventDriven)
+	{
+		updateFlaggedNeurons(firstNeuron, lastNeuron, time, spikingNeurons);
+	}
+	else
+	{
+		State* const inputs(countsSpikes ? incomingSpikes.data() : getSlot(time%ringBufferSize));
+		if(countsSpikes)
+		{
+			addCountedSpikes(firstNeuron, lastNeuron, time%ringBufferSize, inputs);
+		}
+		addBackgroundNoise(firstNeuron, lastNeuron, time, inputs);
+		updateMembranePotentials(firstNeuron, lastNeuron, inputs, spikingNeurons);
+		memset(inputs + firstNeuron, 0, (lastNeuron - firstNeuron)*sizeof(State));	//makes the slot ready to record spikes arriving in another cycle to come
+	}
+	
+	for(size_t i(firstNewSpike); i < spikingNeurons.size(); i++)	//spikes are rare compared to updates, their bookkeeping is left out of the kernel
+	{
+		lastSpikeTimes[spikingNeurons[i]] = time;
+	}
+}
+
+template<typename State>
+void BasicNeuronPopulation<State>::incrementInternalTime(unsigned int numberOfSteps)
+{ internalTime += numberOfSteps; }
+
+template<typename State>
+void BasicNeuronPopulation<State>::receiveSpike(unsigned int neuronId, unsigned int timeOfSpike, double spikeAmplitude)
+{
+	if(countsSpikes)
+	{
+		getSpikeCounts((signalDelay + timeOfSpike)%ringBufferSize, spikeAmplitude)[neuronId]++;
+	}
+	else
+	{
+		incomingSpikes[ringBufferIndex(neuronId, signalDelay + timeOfSpike)] += representation.fromMillivolts(spikeAmplitude);	//read when the signal delay has passed, whether the receiving neuron has already been updated in this step or not
+	}
+	if(eventDriven)
+	{
+		flag(neuronId, (signalDelay + timeOfSpike)%ringBufferSize);
+	}
+}
+
+template<typename State>
+void BasicNeuronPopulation<State>::receiveSpike(const uint32_t* firstNeuronId, const uint32_t* lastNeuronId, unsigned int timeOfSpike, double spikeAmplitude)
+{
+	const size_t slot((signalDelay + timeOfSpike)%ringBufferSize);	//the same for all the targets
+	if(countsSpikes)	//an increment of a small integer, the amplitude is applied once when the slot is read
+	{
+		uint16_t* const counts(getSpikeCounts(slot, spikeAmplitude));
+		for(const uint32_t* neuronId(firstNeuronId); neuronId != lastNeuronId; ++neuronId)
+		{
+			assert(*neuronId < size());
+			counts[*neuronId]++;
+		}
+	}
+	else
+	{
+		State* const inputs(getSlot(slot));
+		const State amplitude(representation.fromMillivolts(spikeAmplitude));
+		for(const uint32_t* neuronId(firstNeuronId); neuronId != lastNeuronId; ++neuronId)
+		{
+			assert(*neuronId < size());
+			inputs[*neuronId] += amplitude;
+		}
+	}
+	
+	if(eventDriven)
+	{
+		for(const uint32_t* neuronId(firstNeuronId); neuronId != lastNeuronId; ++neuronId)
+		{
+			flag(*neuronId, slot);
+		}
+	}
+}
+
+template<typename State>
+void BasicNeuronPopulation<State>::receiveSpikeAtomically(const uint32_t* firstNeuronId, const uint32_t* lastNeuronId, unsigned int timeOfSpike, double spikeAmplitude)
+{
+	assert(countsSpikes);
+	const size_t slot((signalDelay + timeOfSpike)%ringBufferSize);
+	uint16_t* const counts(getSpikeCounts(slot, spikeAmplitude));
+	for(const uint32_t* neuronId(firstNeuronId); neuronId != lastNeuronId; ++neuronId)
+	{
+		assert(*neuronId < size());
+		__atomic_fetch_add(counts + *neuronId, 1, __ATOMIC_RELAXED);	//no ordering needed, the counts are read after the threads have been joined
+	}
+	
+	if(eventDriven)	//neighbouring neurons share the words of flags
+	{
+		for(const uint32_t* neuronId(firstNeuronId); neuronId != lastNeuronId; ++neuronId)
+		{
+			__atomic_fetch_or(&pendingNeurons[slot*numberOfWordsPerSlot + *neuronId/64], uint64_t(1) << (*neuronId%64), __ATOMIC_RELAXED);
+		}
+	}
+}
+
+template<typename State>
+void BasicNeuronPopulation<State>::receiveSpikeCounts(size_t firstNeuron, size_t lastNeuron, unsigned int timeOfSpikes, const uint16_t* excitatoryCounts, const uint16_t* inhibitoryCounts)
+{
+	assert(countsSpikes);
+	assert(firstNeuron%BLOCK_SIZE == 0 and (lastNeuron%BLOCK_SIZE == 0 or lastNeuron == size()));
+	const size_t slot((signalDelay + timeOfSpikes)%ringBufferSize);
+	uint16_t* const ownExcitatoryCounts(spikeCounts.data() + 2*slot*slotSize);
+	uint16_t* const ownInhibitoryCounts(ownExcitatoryCounts + slotSize);
+	for(size_t i(firstNeuron); i < lastNeuron; i++)
+	{
+		ownExcitatoryCounts[i] += excitatoryCounts[i];
+		ownInhibitoryCounts[i] += inhibitoryCounts[i];
+	}
+	
+	for(size_t i(firstNeuron); eventDriven and i < lastNeuron; i++)	//the range starts at a multiple of 64, no other thread shares its words of flags
+	{
+		if(excitatoryCounts[i] > 0 or inhibitoryCounts[i] > 0)
+		{
+			flag(i, slot);
+		}
+	}
+}
+
+template<typename State>
+void BasicNeuronPopulation<State>::addCountedSpikes(size_t firstNeuron, size_t lastNeuron, size_t slot, State* inputs)
+{
+	uint16_t* const excitatoryCounts(spikeCounts.data() + 2*slot*slotSize);
+	uint16_t* const inhibitoryCounts(excitatoryCounts + slotSize);
+	const State excitatoryAmplitude(representation.fromMillivolts(excitatorySpikeAmplitude));
+	const State inhibitoryAmplitude(representation.fromMillivolts(inhibitorySpikeAmplitude));
+	for(size_t i(firstNeuron); i < lastNeuron; i++)
+	{
+		inputs[i] += excitatoryAmplitude*static_cast<State>(excitatoryCounts[i]) + inhibitoryAmplitude*static_cast<State>(inhibitoryCounts[i]);
+	}
+	memset(excitatoryCounts + firstNeuron, 0, (lastNeuron - firstNeuron)*sizeof(uint16_t));
+	memset(inhibitoryCounts + firstNeuron, 0, (lastNeuron - firstNeuron)*sizeof(uint16_t));
+}
+
+template<typename State>
+void BasicNeuronPopulation<State>::addBackgroundNoise(size_t firstNeuron, size_t lastNeuron, unsigned int time, State* inputs)
+{
+	if(hasBackgroundNoise)	//drawn for every neuron, even if a refractory or spiking one ignores it, so that the kernel doesn't need to branch
+	{
+		CounterBasedGenerator::generate(seed, time, firstNeuron, lastNeuron, randomNumbers.data() + firstNeuron);
+		backgroundNoise.addSamples(randomNumbers.data() + firstNeuron, lastNeuron - firstNeuron, spikeAmplitudeOfBackgroundNoise, inputs + firstNeuron);
+	}
+}
+
+template<typename State>
+void BasicNeuronPopulation<State>::updateMembranePotentials(size_t firstNeuron, size_t lastNeuron, const State* inputs, vector<unsigned int>& spikingNeurons)
+{
+	State* const potentials(membranePotentials.data());
+	unsigned int* const counters(refractoryCounters.data());
+	
+	for(size_t i(updateVectorsOfMembranePotentials(firstNeuron, lastNeuron, inputs, spikingNeurons)); i < lastNeuron; i++)	//scalar version, processes the neurons left over by the vectorized loop
+	{
+		const bool isActive(counters[i] == 0);
+		const bool isSpiking(isActive and potentials[i] >= membranePotentialThreshold);
+		const State integrated(StateRepresentation<State>::multiply(potentials[i], decayOfMembranePotential) + inputs[i]);
+		
+		potentials[i] = isSpiking ? resetMembranePotential : (isActive ? integrated : potentials[i]);
+		counters[i] = isSpiking ? refractoryCounterAfterSpike : (isActive ? 0 : counters[i] - 1);
+		if(isSpiking)
+		{
+			spikingNeurons.push_back(i);
+		}
+	}
+}
+
+template<typename State>
+size_t BasicNeuronPopulation<State>::updateVectorsOfMembranePotentials(size_t firstNeuron, size_t, const State*, vector<unsigned int>&)
+{ return firstNeuron; }	//the fixed point kernel is left to the compiler
+
+template<>
+size_t BasicNeuronPopulation<double>::updateVectorsOfMembranePotentials(size_t firstNeuron, size_t lastNeuron, const double* inputs, vector<unsigned int>& spikingNeurons)
+{
+	double* const potentials(membranePotentials.data());
+	unsigned int* const counters(refractoryCounters.data());
+	size_t i(firstNeuron);
+	
+#if defined(__AVX512F__) && defined(__AVX512VL__)
+	const __m512d decay(_mm512_set1_pd(decayOfMembranePotential));
+	const __m512d threshold(_mm512_set1_pd(membranePotentialThreshold));
+	const __m512d reset(_mm512_set1_pd(resetMembranePotential));
+	const __m256i zero(_mm256_setzero_si256());
+	const __m256i one(_mm256_set1_epi32(1));
+	const __m256i counterAfterSpike(_mm256_set1_epi32(refractoryCounterAfterSpike));
+	for(; i + 8 <= lastNeuron; i += 8)
+	{
+		__m512d potential(_mm512_loadu_pd(potentials + i));
+		__m256i counter(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(counters + i)));
+		const __mmask8 isActive(_mm256_cmpeq_epi32_mask(counter, zero));
+		const __mmask8 isSpiking(isActive & _mm512_cmp_pd_mask(potential, threshold, _CMP_GE_OQ));
+		const __m512d integrated(_mm512_add_pd(_mm512_mul_pd(potential, decay), _mm512_loadu_pd(inputs + i)));
+		
+		potential = _mm512_mask_blend_pd(isActive, potential, integrated);
+		potential = _mm512_mask_blend_pd(isSpiking, potential, reset);
+		counter = _mm256_mask_sub_epi32(counter, static_cast<__mmask8>(~isActive), counter, one);
+		counter = _mm256_mask_mov_epi32(counter, isSpiking, counterAfterSpike);
+		_mm512_storeu_pd(potentials + i, potential);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(counters + i), counter);
+		
+		for(unsigned int spikes(isSpiking); spikes != 0; spikes &= spikes - 1)
+		{
+			spikingNeurons.push_back(i + __builtin_ctz(spikes));
+		}
+	}
+#elif defined(__AVX2__)
+	const __m256d decay(_mm256_set1_pd(decayOfMembranePotential));
+	const __m256d threshold(_mm256_set1_pd(membranePotentialThreshold));
+	const __m256d reset(_mm256_set1_pd(resetMembranePotential));
+	const __m128i zero(_mm_setzero_si128());
+	const __m128i one(_mm_set1_epi32(1));
+	const __m128i counterAfterSpike(_mm_set1_epi32(refractoryCounterAfterSpike));
+	const __m256i lowHalves(_mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));	//narrows four 64 bit masks to four 32 bit ones
+	for(; i + 4 <= lastNeuron; i += 4)
+	{
+		__m256d potential(_mm256_loadu_pd(potentials + i));
+		__m128i counter(_mm_loadu_si128(reinterpret_cast<const __m128i*>(counters + i)));
+		const __m128i isActive(_mm_cmpeq_epi32(counter, zero));	//one 32 bit mask per neuron for the counters
+		const __m256d isActiveWide(_mm256_castsi256_pd(_mm256_cvtepi32_epi64(isActive)));	//one 64 bit mask per neuron for the potentials
+		const __m256d isSpiking(_mm256_and_pd(isActiveWide, _mm256_cmp_pd(potential, threshold, _CMP_GE_OQ)));
+		const __m256d integrated(_mm256_add_pd(_mm256_mul_pd(potential, decay), _mm256_loadu_pd(inputs + i)));
+		
+		potential = _mm256_blendv_pd(potential, integrated, isActiveWide);
+		potential = _mm256_blendv_pd(potential, reset, isSpiking);
+		counter = _mm_sub_epi32(counter, _mm_andnot_si128(isActive, one));
+		const __m128i isSpikingNarrow(_mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(isSpiking), lowHalves)));
+		counter = _mm_blendv_epi8(counter, counterAfterSpike, isSpikingNarrow);
+		_mm256_storeu_pd(potentials + i, potential);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(counters + i), counter);
+		
+		for(unsigned int remainingSpikes(_mm256_movemask_pd(isSpiking)); remainingSpikes != 0; remainingSpikes &= remainingSpikes - 1)
+		{
+			spikingNeurons.push_back(i + __builtin_ctz(remainingSpikes));
+		}
+	}
+#endif
+	return i;
+}
+
+template<>
+size_t BasicNeuronPopulation<float>::updateVectorsOfMembranePotentials(size_t firstNeuron, size_t lastNeuron, const float* inputs, vector<unsigned int>& spikingNeurons)
+{
+	float* const potentials(membranePotentials.data());
+	unsigned int* const counters(refractoryCounters.data());
+	size_t i(firstNeuron);
+	
+#if defined(__AVX512F__)
+	const __m512 decay(_mm512_set1_ps(decayOfMembranePotential));
+	const __m512 threshold(_mm512_set1_ps(membranePotentialThreshold));
+	const __m512 reset(_mm512_set1_ps(resetMembranePotential));
+	const __m512i zero(_mm512_setzero_si512());
+	const __m512i one(_mm512_set1_epi32(1));
+	const __m512i counterAfterSpike(_mm512_set1_epi32(refractoryCounterAfterSpike));
+	for(; i + 16 <= lastNeuron; i += 16)	//twice as many neurons per instruction as in double precision
+	{
+		__m512 potential(_mm512_loadu_ps(potentials + i));
+		__m512i counter(_mm512_loadu_si512(counters + i));
+		const __mmask16 isActive(_mm512_cmpeq_epi32_mask(counter, zero));
+		const __mmask16 isSpiking(isActive & _mm512_cmp_ps_mask(potential, threshold, _CMP_GE_OQ));
+		const __m512 integrated(_mm512_add_ps(_mm512_mul_ps(potential, decay), _mm512_loadu_ps(inputs + i)));
+		
+		potential = _mm512_mask_blend_ps(isActive, potential, integrated);
+		potential = _mm512_mask_blend_ps(isSpiking, potential, reset);
+		counter = _mm512_mask_sub_epi32(counter, static_cast<__mmask16>(~isActive), counter, one);
+		counter = _mm512_mask_mov_epi32(counter, isSpiking, counterAfterSpike);
+		_mm512_storeu_ps(potentials + i, potential);
+		_mm512_storeu_si512(counters + i, counter);
+		
+		for(unsigned int spikes(isSpiking); spikes != 0; spikes &= spikes - 1)
+		{
+			spikingNeurons.push_back(i + __builtin_ctz(spikes));
+		}
+	}
+#elif defined(__AVX2__)
+	const __m256 decay(_mm256_set1_ps(decayOfMembranePotential));
+	const __m256 threshold(_mm256_set1_ps(membranePotentialThreshold));
+	const __m256 reset(_mm256_set1_ps(resetMembranePotential));
+	const __m256i zero(_mm256_setzero_si256());
+	const __m256i one(_mm256_set1_epi32(1));
+	const __m256i counterAfterSpike(_mm256_set1_epi32(refractoryCounterAfterSpike));
+	for(; i + 8 <= lastNeuron; i += 8)	//the potentials and the counters have the same width, their masks don't need to be narrowed
+	{
+		__m256 potential(_mm256_loadu_ps(potentials + i));
+		__m256i counter(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(counters + i)));
+		const __m256i isActive(_mm256_cmpeq_epi32(counter, zero));
+		const __m256 isSpiking(_mm256_and_ps(_mm256_castsi256_ps(isActive), _mm256_cmp_ps(potential, threshold, _CMP_GE_OQ)));
+		const __m256 integrated(_mm256_add_ps(_mm256_mul_ps(potential, decay), _mm256_loadu_ps(inputs + i)));
+		
+		potential = _mm256_blendv_ps(potential, integrated, _mm256_castsi256_ps(isActive));
+		potential = _mm256_blendv_ps(potential, reset, isSpiking);
+		counter = _mm256_sub_epi32(counter, _mm256_andnot_si256(isActive, one));
+		counter = _mm256_blendv_epi8(counter, counterAfterSpike, _mm256_castps_si256(isSpiking));
+		_mm256_storeu_ps(potentials + i, potential);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(counters + i), counter);
+		
+		for(unsigned int remainingSpikes(_mm256_movemask_ps(isSpiking)); remainingSpikes != 0; remainingSpikes &= remainingSpikes - 1)
+		{
+			spikingNeurons.push_back(i + __builtin_ctz(remainingSpikes));
+		}
+	}
+#endif
+	return i;
+}
+
+template<typename State>
+void BasicNeuronPopulation<State>::updateFlaggedNeurons(size_t firstNeuron, size_t lastNeuron, unsigned int time, vector<unsigned int>& spikingNeurons)
+{
+	const size_t currentSlot(time%ringBufferSize);
+	const size_t nextSlot((time + 1)%ringBufferSize);
+	uint64_t* const flags(pendingNeurons.data() + currentSlot*numberOfWordsPerSlot);
+	State* const inputs(countsSpikes ? incomingSpikes.data() : getSlot(currentSlot));
+	uint16_t* const excitatoryCounts(countsSpikes ? spikeCounts.data() + 2*currentSlot*slotSize : nullptr);
+	uint16_t* const inhibitoryCounts(countsSpikes ? excitatoryCounts + slotSize : nullptr);
+	
+	if(hasBackgroundNoise)	//the noise reaches most neurons in every step, it is added to the ring buffer so that the neurons it reaches are treated like the ones a spike reaches
+	{
+		CounterBasedGenerator::generate(seed, time, firstNeuron, lastNeuron, randomNumbers.data() + firstNeuron);
+		for(size_t i(firstNeuron); i < lastNeuron; i++)
+		{
+			const unsigned int numberOfExternalSpikes(backgroundNoise.sample(randomNumbers[i]));
+			if(numberOfExternalSpikes > 0)
+			{
+				inputs[i] += spikeAmplitudeOfBackgroundNoise*static_cast<State>(numberOfExternalSpikes);
+				flag(i, currentSlot);
+			}
+		}
+	}
+	
+	for(size_t word(firstNeuron/64); word*64 < lastNeuron; word++)	//the ranges start at a multiple of BLOCK_SIZE, hence of 64, no other thread shares their words
+	{
+		for(uint64_t remainingNeurons(flags[word]); remainingNeurons != 0; remainingNeurons &= remainingNeurons - 1)
+		{
+			const size_t i(word*64 + __builtin_ctzll(remainingNeurons));
+			State input(inputs[i]);
+			inputs[i] = 0;
+			if(countsSpikes)
+			{
+				input += representation.fromMillivolts(excitatorySpikeAmplitude)*static_cast<State>(excitatoryCounts[i]) + representation.fromMillivolts(inhibitorySpikeAmplitude)*static_cast<State>(inhibitoryCounts[i]);
+				excitatoryCounts[i] = 0;
+				inhibitoryCounts[i] = 0;
+			}
+			if(time < lastUpdateTimes[i])	//refractory, the input is lost
+			{
+				continue;
+			}
+			
+			const State potential(StateRepresentation<State>::multiply(membranePotentials[i], getDecayOverSteps(time - lastUpdateTimes[i])));
+			if(potential >= membranePotentialThreshold)
+			{
+				membranePotentials[i] = resetMembranePotential;
+				lastUpdateTimes[i] = time + refractoryCounterAfterSpike + 1;	//the reset potential doesn't decay while the neuron is refractory
+				spikingNeurons.push_back(i);
+			}
+			else
+			{
+				membranePotentials[i] = StateRepresentation<State>::multiply(potential, decayOfMembranePotential) + input;
+				lastUpdateTimes[i] = time + 1;
+				if(membranePotentials[i] >= membranePotentialThreshold)	//spikes in the next step, whether it receives input or not
+				{
+					flag(i, nextSlot);
+				}
+			}
+		}
+		flags[word] = 0;
+	}
+}
+
+template<typename State>
+void BasicNeuronPopulation<State>::flag(size_t neuronId, size_t slot)
+{ pendingNeurons[slot*numberOfWordsPerSlot + neuronId/64] |= uint64_t(1) << (neuronId%64); }
+
+template<typename State>
+typename BasicNeuronPopulation<State>::Factor BasicNeuronPopulation<State>::getDecayOverSteps(unsigned int numberOfSteps) const
+{ return (numberOfSteps < decayOverSteps.size()) ? decayOverSteps[numberOfSteps] : StateRepresentation<State>::toFactor(pow(decayPerStep, numberOfSteps)); }
+
+template<typename State>
+State* BasicNeuronPopulation<State>::getSlot(size_t slot)
+{ return incomingSpikes.data() + slot*slotSize; }
+
+template<typename State>
+uint16_t* BasicNeuronPopulation<State>::getSpikeCounts(size_t slot, double spikeAmplitude)
+{
+	if(spikeAmplitude != excitatorySpikeAmplitude and spikeAmplitude != inhibitorySpikeAmplitude)
+	{
+		throw invalid_argument("the spikes are counted, their amplitude has to be the one of the excitatory or of the inhibitory neurons");
+	}
+	return spikeCounts.data() + (2*slot + (spikeAmplitude == excitatorySpikeAmplitude ? 0 : 1))*slotSize;
+}
+
+template<typename State>
+size_t BasicNeuronPopulation<State>::ringBufferIndex(unsigned int neuronId, unsigned int time) const
+{
+	const size_t index(time%ringBufferSize*slotSize + neuronId);
+	assert(index < incomingSpikes.size());
+	return index;
+}
+
+template class BasicNeuronPopulation<double>;
+template class BasicNeuronPopulation<float>;
+template class BasicNeuronPopulation<FixedPointState>;
@@ -0,0 +1,261 @@
+#ifndef NEURON_POPULATION_H
+#define NEURON_POPULATION_H
+
+#include "hugePageAllocator.hpp"
+#include "parameters.hpp"
+#include "poissonSampler.hpp"
+#include "simulationConfig.hpp"
+#include "stateRepresentation.hpp"
+
+#include <cstdint>
+#include <vector>
+
+/** The state of all the neurons of a network, stored field by field.
+ * Instead of one heap allocated object per neuron, the population keeps each state variable of all of its neurons in one contiguous array
+   (structure of arrays), so that updating the network walks memory linearly. Neuron i is described by the i-th entry of each array.
+ * The membrane potentials, the ring buffers and the amplitudes are stored as double, float or fixed point numbers, see StateRepresentation, the interface always uses double.
+ * @see Network
+ * @tparam State double, float or FixedPointState */
+template<typename State>
+class BasicNeuronPopulation
+{
+	public:
+
+	static constexpr size_t BLOCK_SIZE = 256; ///< Ranges of neurons that are updated concurrently have to start at a multiple of it, so that two threads never write to the same cache line.
+
+	/** A constructor.
+	 * Creates a population of neurons in their initial state, that is to say at rest, not refractory and with an empty ring buffer.
+	   The background noise is drawn from a randomly seeded generator.
+	 * @param numberOfNeurons the size of the population, a size_t */
+	explicit BasicNeuronPopulation(size_t numberOfNeurons);
+	
+	/** A constructor.
+	 * Creates a population of neurons in their initial state whose background noise only depends on the given seed.
+	 * The background noise of a neuron in a step is drawn from a counter-based random number keyed by the seed, the neuron's id and the step,
+	   it thus doesn't depend on the order in which the neurons are updated nor on how the population is split among threads.
+	 * The neurons follow the model described by a configuration, by default the one of the parameter file.
+	 * @param numberOfNeurons the size of the population, a size_t
+	 * @param seed an unsigned int
+	 * @param config the parameters of the neurons, its number of neurons is ignored */
+	BasicNeuronPopulation(size_t numberOfNeurons, unsigned int seed, const SimulationConfig& config = SimulationConfig());
+
+	//getters
+	/// A getter for the number of neurons in the population.
+	size_t size() const;
+
+	/** A getter for the population's clock, all of its neurons share the same local time.
+	 * @return the number of steps the population has been updated, an unsigned int */
+	unsigned int getInternalTime() const;
+
+	/** A getter for the delay between the emission and the reception of a spike, the number of steps ranges of neurons may advance without receiving spikes.
+	 * @return the signal delay in steps, an unsigned int */
+	unsigned int getSignalDelay() const;
+
+	/** A getter for the membrane potential of one neuron.
+	 * @param neuronId an unsigned int
+	 * @return the neuron's membrane potential, a double */
+	double getMembranePotential(unsigned int neuronId) const;
+
+	/** A getter for the time of the latest spike of one neuron, the population doesn't keep the earlier ones.
+	 * @see Network::addSpikeRecorder
+	 * @param neuronId an unsigned int
+	 * @return the step of the neuron's latest spike, an unsigned int, meaningless as long as the neuron has never spiked */
+	unsigned int getLastSpikeTime(unsigned int neuronId) const;
+
+	/** Tells whether the population only updates the neurons that receive input, see SimulationConfig::isEventDriven.
+	 * @return a bool */
+	bool isEventDriven() const;
+
+	/** Tells whether the ring buffers count the spikes of each population instead of summing their amplitudes, see SimulationConfig::isCountingSpikes.
+	 * @return a bool */
+	bool isCountingSpikes() const;
+
+	//setters
+	/** A setter for the frequency of the background noise arriving from the rest of the brain.
+	 * @see Network::setRatioVextOverVthr
+	 * @param ratioVextOverVthr a double, no background noise at all if it is zero */
+	void setRatioVextOverVthr(double ratioVextOverVthr);
+
+	/** A setter for the amplitudes of the spikes of the excitatory and the inhibitory neurons, by default J and -gJ of the configuration.
+	 * If the spikes are counted, these are the only amplitudes the neurons can receive, and the counted spikes that haven't arrived yet take the new amplitudes.
+	 * @see Network::setRatioJinoverJexG
+	 * @param excitatorySpikeAmplitude a double
+	 * @param inhibitorySpikeAmplitude a double */
+	void setSpikeAmplitudes(double excitatorySpikeAmplitude, double inhibitorySpikeAmplitude);
+
+	//update
+	/**Advances every neuron of the population by one step, in the order of their ids.
+	 * A neuron that is not refractory either spikes if its membrane potential has reached the threshold or integrates the ring buffer's current entry and the background noise.
+	   In the event-driven mode only the neurons that receive input or are about to spike are visited, the others decay lazily.
+	   The spikes are not delivered by the population itself, the ids of the spiking neurons are collected instead so that the network can send them to the targets.
+	 * @see Network::update()
+	 * @param spikingNeurons a vector that receives the ids of the neurons that spiked during this step */
+	void update(std::vector<unsigned int>& spikingNeurons);
+	
+	/**Advances a range of neurons by one step without moving the population's clock forward, which allows to update disjoint ranges concurrently.
+	 * The range may be ahead of the population's clock by less than the signal delay, since no spike emitted in the meantime can reach it before.
+	 * @see update(std::vector<unsigned int>& spikingNeurons)
+	 * @see Network::updateNeurons
+	 * @param firstNeuron the id of the first neuron, a multiple of BLOCK_SIZE
+	 * @param lastNeuron the id past the last neuron, a multiple of BLOCK_SIZE or the size of the population
+	 * @param time the time of the step the neurons perform, at least the population's clock and less than the clock plus the signal delay, an unsigned int
+	 * @param spikingNeurons a vector that receives the ids of the neurons that spiked during this step */
+	void update(size_t firstNeuron, size_t lastNeuron, unsigned int time, std::vector<unsigned int>& spikingNeurons);
+	
+	/**Moves the population's clock forward once all of its neurons have been updated.
+	 * @see update(size_t firstNeuron, size_t lastNeuron, unsigned int time, std::vector<unsigned int>& spikingNeurons)
+	 * @param numberOfSteps an unsigned int */
+	void incrementInternalTime(unsigned int numberOfSteps = 1);
+	
+	/**Stores a spike emitted at a given time in the ring buffer of a neuron, it will be read once the signal delay has passed.
+	 * @see Network::update()
+	 * @throw std::invalid_argument if the spikes are counted and the amplitude is neither the excitatory nor the inhibitory one
+	 * @param neuronId the id of the receiving neuron, an unsigned int
+	 * @param timeOfSpike the time at which the presynaptic neuron spiked, an unsigned int
+	 * @param spikeAmplitude a double */
+	void receiveSpike(unsigned int neuronId, unsigned int timeOfSpike, double spikeAmplitude);
+	
+	/**Stores a spike emitted at a given time in the ring buffers of several neurons, which is how the targets of a spiking neuron are reached.
+	 * @see Network::deliverSpikes
+	 * @throw std::invalid_argument if the spikes are counted and the amplitude is neither the excitatory nor the inhibitory one
+	 * @param firstNeuronId a pointer to the id of the first receiving neuron
+	 * @param lastNeuronId a pointer past the id of the last receiving neuron
+	 * @param timeOfSpike the time at which the presynaptic neuron spiked, an unsigned int
+	 * @param spikeAmplitude the amplitude of the spikes of the presynaptic neuron's population, a double */
+	void receiveSpike(const std::uint32_t* firstNeuronId, const std::uint32_t* lastNeuronId, unsigned int timeOfSpike, double spikeAmplitude);
+	
+	/**Stores a spike as receiveSpike does, but with atomic increments of the counts, so that several threads may deliver spikes to the same neurons at the same time.
+	 * Only possible if the spikes are counted.
+	 * @see Network::DeliveryStrategy
+	 * @throw std::invalid_argument if the amplitude is neither the excitatory nor the inhibitory one
+	 * @param firstNeuronId a pointer to the id of the first receiving neuron
+	 * @param lastNeuronId a pointer past the id of the last receiving neuron
+	 * @param timeOfSpike the time at which the presynaptic neuron spiked, an unsigned int
+	 * @param spikeAmplitude the amplitude of the spikes of the presynaptic neuron's population, a double */
+	void receiveSpikeAtomically(const std::uint32_t* firstNeuronId, const std::uint32_t* lastNeuronId, unsigned int timeOfSpike, double spikeAmplitude);
+	
+	/**Adds the spikes a range of neurons received at a given time, counted elsewhere, to their ring buffers. Only possible if the spikes are counted.
+	 * @see Network::DeliveryStrategy
+	 * @param firstNeuron the id of the first neuron, a multiple of BLOCK_SIZE
+	 * @param lastNeuron the id past the last neuron, a multiple of BLOCK_SIZE or the size of the population
+	 * @param timeOfSpikes the time at which the presynaptic neurons spiked, an unsigned int
+	 * @param excitatoryCounts a pointer to the number of excitatory spikes of the neuron of id 0
+	 * @param inhibitoryCounts a pointer to the number of inhibitory spikes of the neuron of id 0 */
+	void receiveSpikeCounts(size_t firstNeuron, size_t lastNeuron, unsigned int timeOfSpikes, const std::uint16_t* excitatoryCounts, const std::uint16_t* inhibitoryCounts);
+
+	private:
+
+	typedef typename StateRepresentation<State>::Factor Factor; ///< The type of the factors the membrane potentials are multiplied by.
+
+	StateRepresentation<State> representation; ///< How the potentials are converted from and to mV.
+	unsigned int signalDelay; ///< The delay between the emission and the reception of a spike, in steps.
+	size_t ringBufferSize; ///< The number of ring buffer slots per neuron, one more than the signal delay. Like slotSize it is only used once per step or per spiking neuron, never per element, so constants for the parameter file's values don't speed the update up measurably.
+	double decayPerStep; ///< The factor by which the membrane potential decays during one step, in double precision for the decay over long silences.
+	Factor decayOfMembranePotential; ///< The factor by which the membrane potential decays during one step, as stored.
+	State membranePotentialThreshold; ///< The membrane potential at which a neuron spikes.
+	State resetMembranePotential; ///< The membrane potential just after a spike.
+	unsigned int refractoryCounterAfterSpike; ///< The number of steps a neuron stays refractory after the step in which it spikes.
+	State spikeAmplitudeOfBackgroundNoise; ///< The amplitude of the spikes arriving from the rest of the brain, the one of the excitatory neurons.
+	double meanNumberOfExternalSpikesPerRatio; ///< The mean number of spikes arriving from the rest of the brain in one step for a ratio Vext/Vthr of one.
+
+	std::vector<State> membranePotentials; ///< The membrane potential of each neuron.
+	std::vector<unsigned int> lastSpikeTimes; ///< The time of each neuron's latest spike, meaningless as long as the neuron has never spiked.
+	std::vector<unsigned int> refractoryCounters; ///< The number of steps each neuron still has to spend in the refractory state.
+	size_t slotSize; ///< The number of entries of a ring buffer slot, the number of neurons rounded up to a multiple of BLOCK_SIZE so that each slot starts on a cache line of its own.
+	bool countsSpikes; ///< True if the ring buffers count the spikes of each population, see SimulationConfig::isCountingSpikes.
+	std::vector<State, HugePageAllocator<State> > incomingSpikes; ///< The ring buffers of all the neurons as a matrix of ringBufferSize slots of slotSize entries, the entry of neuron i in a slot is the i-th one, in huge pages since the spikes are added in random order. A single slot gathering the input of the current step if the spikes are counted.
+	std::vector<std::uint16_t, HugePageAllocator<std::uint16_t> > spikeCounts; ///< If the spikes are counted, the ring buffers as a matrix of ringBufferSize slots, each made of slotSize excitatory counts followed by slotSize inhibitory ones.
+	double excitatorySpikeAmplitude; ///< The amplitude of the spikes of the excitatory neurons, in mV.
+	double inhibitorySpikeAmplitude; ///< The amplitude of the spikes of the inhibitory neurons, in mV.
+
+	unsigned int internalTime; ///< The population's clock, an unsigned int.
+
+	unsigned int seed; ///< The seed of the random generators drawing the background noise.
+	PoissonSampler backgroundNoise; ///< The number of spikes arriving from the rest of the brain in one step, tabulated once since its mean stays the same.
+	bool hasBackgroundNoise; ///< False if the population doesn't receive any stimulation from the rest of the brain.
+	std::vector<std::uint32_t> randomNumbers; ///< The random numbers the background noise of the current step is drawn from, one per neuron.
+
+	bool eventDriven; ///< True if only the neurons that receive input or are about to spike are updated, see SimulationConfig::isEventDriven.
+	std::vector<unsigned int> lastUpdateTimes; ///< In the event-driven mode, the step at the beginning of which each neuron had the stored membrane potential, or at which it stops being refractory.
+	std::vector<Factor> decayOverSteps; ///< The factor by which the membrane potential decays during 0, 1, 2... steps, computed once for the lazy updates.
+	size_t numberOfWordsPerSlot; ///< The number of 64 bit words a ring buffer slot needs to flag each neuron.
+	std::vector<std::uint64_t> pendingNeurons; ///< In the event-driven mode, one bit per neuron and ring buffer slot, set if the neuron has to be visited in the corresponding step.
+
+	/**Adds the counted spikes of a slot, multiplied by their amplitudes, to the inputs of a range of neurons and clears the counts.
+	 * @see update()
+	 * @param firstNeuron the id of the first neuron, a size_t
+	 * @param lastNeuron the id past the last neuron, a size_t
+	 * @param slot the index of the slot, a size_t
+	 * @param inputs a pointer to the inputs of the step */
+	void addCountedSpikes(size_t firstNeuron, size_t lastNeuron, size_t slot, State* inputs);
+	
+	/**Adds the background noise of a step to the inputs of a range of neurons.
+	 * @see update()
+	 * @param firstNeuron the id of the first neuron, a size_t
+	 * @param lastNeuron the id past the last neuron, a size_t
+	 * @param time the time of the step, an unsigned int
+	 * @param inputs a pointer to the inputs of the step */
+	void addBackgroundNoise(size_t firstNeuron, size_t lastNeuron, unsigned int time, State* inputs);
+	
+	/**The update kernel, advances the membrane potential and the refractory counter of a range of neurons in a single pass without branching.
+	 * A neuron that isn't refractory and whose membrane potential has reached the threshold spikes and is reset,
+	   one that isn't refractory and doesn't spike decays and integrates its input, a refractory one only counts down.
+	   Uses AVX-512 or AVX2 instructions if the program is compiled for a processor that supports them, the scalar loop handles the remaining neurons otherwise.
+	 * @see update()
+	 * @param firstNeuron the id of the first neuron, a size_t
+	 * @param lastNeuron the id past the last neuron, a size_t
+	 * @param inputs a pointer to the inputs of the step, which already contain the spikes and the background noise
+	 * @param spikingNeurons a vector that receives the ids of the neurons that spiked, in increasing order */
+	void updateMembranePotentials(size_t firstNeuron, size_t lastNeuron, const State* inputs, std::vector<unsigned int>& spikingNeurons);
+	
+	/**The vectorized part of the update kernel, which exists for double and float, advances the neurons of a range by whole vectors from the first one on.
+	 * @see updateMembranePotentials
+	 * @param firstNeuron the id of the first neuron, a size_t
+	 * @param lastNeuron the id past the last neuron, a size_t
+	 * @param inputs a pointer to the inputs of the step, which already contain the spikes and the background noise
+	 * @param spikingNeurons a vector that receives the ids of the neurons that spiked, in increasing order
+	 * @return the id of the first neuron left for the scalar loop, a size_t */
+	size_t updateVectorsOfMembranePotentials(size_t firstNeuron, size_t lastNeuron, const State* inputs, std::vector<unsigned int>& spikingNeurons);
+	
+	/**The update of the event-driven mode, visits only the neurons of a range that have been flagged for a step and catches up on the decay they missed since their last visit.
+	 * A neuron is flagged when a spike or the background noise reaches it, or when the input it integrated lifted it to the threshold so that it spikes in the next step.
+	   Since the membrane potential only decays towards zero in between, which lies below the threshold, a neuron that isn't flagged can't spike, and leaving it alone gives the same result as updating it.
+	 * @see update()
+	 * @param firstNeuron the id of the first neuron, a size_t
+	 * @param lastNeuron the id past the last neuron, a size_t
+	 * @param time the time of the step, an unsigned int
+	 * @param spikingNeurons a vector that receives the ids of the neurons that spiked, in increasing order */
+	void updateFlaggedNeurons(size_t firstNeuron, size_t lastNeuron, unsigned int time, std::vector<unsigned int>& spikingNeurons);
+	
+	/**Flags a neuron so that the event-driven update visits it in a given step.
+	 * @param neuronId a size_t
+	 * @param slot the ring buffer slot of the step, a size_t */
+	void flag(size_t neuronId, size_t slot);
+	
+	/**The factor by which the membrane potential decays during a number of steps.
+	 * @param numberOfSteps an unsigned int
+	 * @return the factor as stored */
+	Factor getDecayOverSteps(unsigned int numberOfSteps) const;
+	
+	/**Auxiliary method that yields a slot of the ring buffers, whose entries are the inputs of all the neurons in the same step.
+	 * @param slot the index of the slot, less than the size of the ring buffers
+	 * @return a pointer to the entry of the neuron of id 0 */
+	State* getSlot(size_t slot);
+	
+	/**Auxiliary method that yields the counts of the spikes of one population in a slot of the ring buffers.
+	 * @throw std::invalid_argument if the amplitude is neither the excitatory nor the inhibitory one
+	 * @param slot the index of the slot, less than the size of the ring buffers
+	 * @param spikeAmplitude the amplitude of the spikes, which tells their population, a double
+	 * @return a pointer to the count of the neuron of id 0 */
+	std::uint16_t* getSpikeCounts(size_t slot, double spikeAmplitude);
+	
+	/**Auxiliary method that yields the index of a neuron's ring buffer slot that corresponds to a given time.
+	 * @param neuronId an unsigned int
+	 * @param time an unsigned int
+	 * @return the index in incomingSpikes, a size_t */
+	size_t ringBufferIndex(unsigned int neuronId, unsigned int time) const;
+};
+
+typedef BasicNeuronPopulation<double> NeuronPopulation; ///< The reference population, whose state is stored in double precision.
+
+#endif
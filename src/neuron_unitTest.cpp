@@ -1,21 +1,57 @@
 #include "gtest/gtest.h"
+#include "asynchronousSpikeRecorder.hpp"
+#include "binarySpikeReader.hpp"
+#include "binarySpikeRecorder.hpp"
+#include "connectivity.hpp"
+#include "counterBasedGenerator.hpp"
+#include "hugePageAllocator.hpp"
 #include "network.hpp"
 #include "neuron.hpp"
+#include "neuronPopulation.hpp"
+#include "parameterSweep.hpp"
 #include "parameters.hpp"
+#include "poissonSampler.hpp"
 #include "simulation.hpp"
+#include "simulationConfig.hpp"
+#include "spikeRecorder.hpp"
+#include "spikeRaster.hpp"
+#include "spikeRasterRecorder.hpp"
+#include "workerPool.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
 #include <vector> 
 
- void updateNeuronNTimes(Neuron& neuron, const unsigned int n) //auxilliary function that allows to update a neuron n times
+ void updateNeuronNTimes(Neuron& neuron, const unsigned int n) //auxilliary function that allows to update a neuron n times, each step followed by the delivery of its spike
 {
 	
 	for(size_t i(0);i < n;++i)
 	{
 		neuron.updateWithoutBackgroundNoise();
+		neuron.deliverSpike();
 	}
 	
+}
+
+template<typename NetworkType>
+void expectSameEvolution(const NetworkType& referenceNetwork, const NetworkType& network, const unsigned int numberOfNeurons, const unsigned int duration) //auxilliary function that tests if two networks updated for the same duration evolved exactly the same way, with the same mean spike rate, which isn't zero, and bit for bit the same membrane potentials
+{
+	EXPECT_GT(referenceNetwork.getMeanSpikeRateInInterval(0,duration),0);
+	EXPECT_EQ(referenceNetwork.getMeanSpikeRateInInterval(0,duration),network.getMeanSpikeRateInInterval(0,duration));
+	for(unsigned int i(0); i < numberOfNeurons; i++)
+	{
+		ASSERT_EQ(referenceNetwork.getMembranePotential(i),network.getMembranePotential(i)); //bit for bit
+	}
 }
  
  /*
@@ -87,6 +123,8 @@ TEST(twoNeurons, ringBuffer) //tests if a spike arrive with the right delay and
 	EXPECT_TRUE(n1.getSpikeTime().empty());
 	n1.updateWithoutBackgroundNoise();
 	EXPECT_FALSE(n1.getSpikeTime().empty());//tests if it spiked
+	n1.deliverSpike();
+	n1.deliverSpike();	//the spike is only delivered once
 		
 	for(size_t i(0);i < SIGNAL_DELAY_D;i++)
 	{
@@ -133,17 +171,37 @@ TEST(neuronalNetwork, initialisation) //tests if each neuron receives the correc
 	
 }
 
-TEST(oneNeuron, randomBackgroundNoise) //tests if the variance resp. the expected value of the expression a*poissson(x) is equal to a*a*var(poisson(x)) resp. a*mean(poisson(x)) as expected
+TEST(oneNeuron, randomBackgroundNoise) //tests if the variance resp. the expected value of the expression a*poissson(x) is equal to a*a*var(poisson(x)) resp. a*mean(poisson(x)) as expected, and that the noise only depends on the seed, the neuron's id and the step
 {
-	Neuron neuron;
+	Neuron neuron(7);
 	
 	std::vector<double> backgroundNoise;
 	
 	for(size_t i(0);i<1000000;i++)// calculate expected value
 	{
 		backgroundNoise.push_back(neuron.getBackgroundNoise());
+		EXPECT_EQ(backgroundNoise.back(),neuron.getBackgroundNoise());	//the same step
+		neuron.updateWithoutBackgroundNoise();	//the next step
 	}
 	
+	Neuron sameNeuron(7);
+	Neuron otherNeuron(8);
+	Neuron otherSeed(7, NOISE_SEED_BY_DEFAULT + 1);
+	std::vector<double> sameNoise, otherNoise, otherSeedNoise;
+	for(size_t i(0);i<1000;i++)
+	{
+		sameNoise.push_back(sameNeuron.getBackgroundNoise());
+		otherNoise.push_back(otherNeuron.getBackgroundNoise());
+		otherSeedNoise.push_back(otherSeed.getBackgroundNoise());
+		for(Neuron* n: {&sameNeuron, &otherNeuron, &otherSeed})
+		{
+			n->updateWithoutBackgroundNoise();
+		}
+	}
+	EXPECT_EQ(std::vector<double>(backgroundNoise.begin(), backgroundNoise.begin() + 1000),sameNoise);
+	EXPECT_NE(sameNoise,otherNoise);
+	EXPECT_NE(sameNoise,otherSeedNoise);
+	
 	double meanValue(std::accumulate(backgroundNoise.begin(), backgroundNoise.end(), 0.0) / backgroundNoise.size());
 	
 	EXPECT_NEAR(RATIO_V_EXTERNAL_OVER_V_THRESHOLD*MEMBRANE_POTENTIAL_THRESHOLD*MIN_TIME_INTERVAL_H/TIME_CONSTANT_TAU, meanValue, 0.001);//tests if the expected value is the right one
@@ -156,6 +214,781 @@ TEST(oneNeuron, randomBackgroundNoise) //tests if the variance resp. the expecte
 	
 }
 
+TEST(counterBasedGenerator, philox) //tests the bijection against known answers published with the Random123 library and that a generator only depends on its seed, stream and position
+{
+	typedef std::array<std::uint32_t, 4> Block;
+	EXPECT_EQ(Block({{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}}),CounterBasedGenerator::philox({{0, 0, 0, 0}}, {{0, 0}}));
+	EXPECT_EQ(Block({{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}}),CounterBasedGenerator::philox({{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}}, {{0xffffffff, 0xffffffff}}));
+	EXPECT_EQ(Block({{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}),CounterBasedGenerator::philox({{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}}, {{0xa4093822, 0x299f31d0}}));
+	
+	CounterBasedGenerator generator(1, 2, 3);
+	CounterBasedGenerator sameGenerator(1, 2, 3);
+	CounterBasedGenerator otherStream(1, 3, 3);
+	CounterBasedGenerator otherPosition(1, 2, 4);
+	for(size_t i(0); i < 10; i++) //more than one block
+	{
+		const std::uint32_t number(generator());
+		EXPECT_EQ(number,sameGenerator());
+		EXPECT_NE(number,otherStream());
+		EXPECT_NE(number,otherPosition());
+	}
+}
+
+TEST(poissonSampler, meanAndVariance) //tests if the samples drawn from counter-based random numbers have the mean and the variance of a poisson distribution, that the probability of zero is right and that a mean of zero always yields zero
+{
+	const double mean(0.9);
+	const size_t numberOfSamples(1000000);
+	PoissonSampler sampler(mean);
+	std::vector<std::uint32_t> randomNumbers(numberOfSamples);
+	CounterBasedGenerator::generate(42, 0, 0, numberOfSamples, randomNumbers.data());
+	
+	std::vector<double> samples(numberOfSamples, 0);
+	sampler.addSamples(randomNumbers.data(), numberOfSamples, 1, samples.data());
+	double sampleMean(std::accumulate(samples.begin(), samples.end(), 0.0)/numberOfSamples);
+	double sampleVariance(0);
+	size_t numberOfZeros(0);
+	for(auto sample: samples)
+	{
+		sampleVariance += (sample - sampleMean)*(sample - sampleMean)/numberOfSamples;
+		numberOfZeros += (sample == 0);
+	}
+	EXPECT_NEAR(mean,sampleMean,0.005);
+	EXPECT_NEAR(mean,sampleVariance,0.01);
+	EXPECT_NEAR(std::exp(-mean),double(numberOfZeros)/numberOfSamples,0.002);
+	
+	PoissonSampler noSampler(0);
+	for(size_t i(0); i < 1000; i++)
+	{
+		EXPECT_EQ(0u,noSampler.sample(randomNumbers[i]));
+	}
+}
+
+TEST(neuronPopulation, ringBuffer) //tests if a spike stored in the population's ring buffers arrives with the right delay and amplitude, and that a neuron spikes and stays refractory as the single neuron does
+{
+	NeuronPopulation population(2);
+	population.setRatioVextOverVthr(0);	//no background noise
+	std::vector<unsigned int> spikingNeurons;
+	
+	population.receiveSpike(1, population.getInternalTime(), SPIKE_AMPLITUDE_J);
+	for(size_t i(0);i < SIGNAL_DELAY_D;i++)
+	{
+		population.update(spikingNeurons);
+		EXPECT_NEAR(population.getMembranePotential(1),0,0.00001); //Verifies that the spike doesn't arrive before it is supposed to
+	}
+	population.update(spikingNeurons);
+	EXPECT_NEAR(population.getMembranePotential(1),SPIKE_AMPLITUDE_J,0.00001);
+	EXPECT_NEAR(population.getMembranePotential(0),0,0.00001); //the neighbour isn't affected
+	
+	population.receiveSpike(0, population.getInternalTime(), 2*MEMBRANE_POTENTIAL_THRESHOLD); //makes neuron 0 reach the threshold
+	for(size_t i(0);i <= SIGNAL_DELAY_D;i++)
+	{
+		population.update(spikingNeurons);
+	}
+	EXPECT_TRUE(spikingNeurons.empty());
+	const unsigned int timeOfSpike(population.getInternalTime());
+	population.update(spikingNeurons);
+	ASSERT_EQ(1u,spikingNeurons.size());
+	EXPECT_EQ(0u,spikingNeurons[0]);
+	EXPECT_EQ(timeOfSpike,population.getLastSpikeTime(0));
+	EXPECT_EQ(RESET_MEMBRANE_POTENTIAL,population.getMembranePotential(0));
+	
+	population.receiveSpike(0, population.getInternalTime() - SIGNAL_DELAY_D, SPIKE_AMPLITUDE_J); //arrives during the refractory period and is lost
+	for(size_t i(1);i < REFRACTION_PERIOD;i++)
+	{
+		population.update(spikingNeurons);
+	}
+	EXPECT_EQ(RESET_MEMBRANE_POTENTIAL,population.getMembranePotential(0));
+}
+
+TEST(neuronPopulation, updateKernel) //tests if the neurons processed by the vectorized kernel and the ones left over for the scalar loop spike at the right time and in the order of their ids
+{
+	constexpr unsigned int n(19); //not a multiple of the vector widths
+	NeuronPopulation population(n);
+	population.setRatioVextOverVthr(0);	//no background noise
+	std::vector<unsigned int> spikingNeurons;
+	
+	for(unsigned int t(0); t < SIGNAL_DELAY_D + REFRACTION_PERIOD + 3; t++)
+	{
+		for(unsigned int i(0); i < n; i++)
+		{
+			if(t == i%3)
+			{
+				population.receiveSpike(i, t, 2*MEMBRANE_POTENTIAL_THRESHOLD); //neuron i crosses the threshold at time i%3+D and spikes in the next step
+			}
+			if(t == i%3 + 2)
+			{
+				population.receiveSpike(i, t, SPIKE_AMPLITUDE_J); //arrives during the refractory period and is lost
+			}
+		}
+		spikingNeurons.clear();
+		population.update(spikingNeurons);
+		
+		std::vector<unsigned int> expectedSpikingNeurons;
+		for(unsigned int i(0); i < n; i++)
+		{
+			if(t == i%3 + SIGNAL_DELAY_D + 1)
+			{
+				expectedSpikingNeurons.push_back(i);
+			}
+		}
+		EXPECT_EQ(expectedSpikingNeurons,spikingNeurons);
+	}
+	
+	for(unsigned int i(0); i < n; i++)
+	{
+		EXPECT_EQ(i%3 + SIGNAL_DELAY_D + 1,population.getLastSpikeTime(i));
+		EXPECT_EQ(RESET_MEMBRANE_POTENTIAL,population.getMembranePotential(i));
+	}
+}
+
+TEST(neuronPopulation, eventDriven) //tests if the population that only updates the neurons receiving input spikes at the same times as the one that updates all of them, and if the membrane potentials it catches up on agree
+{
+	constexpr unsigned int n(300);
+	SimulationConfig config;
+	config.ratioVextOverVthr = 0.5;	//leaves many neurons without background noise in a step
+	NeuronPopulation densePopulation(n, 11, config);
+	config.isEventDriven = true;
+	NeuronPopulation eventDrivenPopulation(n, 11, config);
+	EXPECT_TRUE(eventDrivenPopulation.isEventDriven());
+	std::vector<unsigned int> denseSpikingNeurons, eventDrivenSpikingNeurons;
+	
+	for(unsigned int t(0); t < 400; t++)
+	{
+		for(unsigned int i(t%7); i < n; i += 7)	//sparse input, some of it strong enough to reach the threshold
+		{
+			const double spikeAmplitude((i*t)%5 == 0 ? MEMBRANE_POTENTIAL_THRESHOLD : -SPIKE_AMPLITUDE_J);
+			densePopulation.receiveSpike(i, t, spikeAmplitude);
+			eventDrivenPopulation.receiveSpike(i, t, spikeAmplitude);
+		}
+		denseSpikingNeurons.clear();
+		eventDrivenSpikingNeurons.clear();
+		densePopulation.update(denseSpikingNeurons);
+		eventDrivenPopulation.update(eventDrivenSpikingNeurons);
+		ASSERT_EQ(denseSpikingNeurons,eventDrivenSpikingNeurons);
+		
+		for(unsigned int i(0); i < n; i++)
+		{
+			ASSERT_NEAR(densePopulation.getMembranePotential(i),eventDrivenPopulation.getMembranePotential(i),1e-9);
+		}
+	}
+	EXPECT_GT(densePopulation.getLastSpikeTime(0),0u);
+}
+
+TEST(neuronPopulation, reducedPrecision) //tests if the populations storing their state in single precision and in fixed point spike at the same times as the one storing it in double precision, with membrane potentials close to its own
+{
+	constexpr unsigned int n(300);
+	SimulationConfig config;
+	config.ratioVextOverVthr = 0.5;
+	NeuronPopulation referencePopulation(n, 11, config);
+	BasicNeuronPopulation<float> singlePrecisionPopulation(n, 11, config);
+	BasicNeuronPopulation<FixedPointState> fixedPointPopulation(n, 11, config);
+	std::vector<unsigned int> referenceSpikingNeurons, singlePrecisionSpikingNeurons, fixedPointSpikingNeurons;
+	
+	for(unsigned int t(0); t < 400; t++)
+	{
+		for(unsigned int i(t%7); i < n; i += 7)	//the same input as in the event-driven test, far enough from the threshold that the rounding doesn't change the spikes
+		{
+			const double spikeAmplitude((i*t)%5 == 0 ? MEMBRANE_POTENTIAL_THRESHOLD : -SPIKE_AMPLITUDE_J);
+			referencePopulation.receiveSpike(i, t, spikeAmplitude);
+			singlePrecisionPopulation.receiveSpike(i, t, spikeAmplitude);
+			fixedPointPopulation.receiveSpike(i, t, spikeAmplitude);
+		}
+		referenceSpikingNeurons.clear();
+		singlePrecisionSpikingNeurons.clear();
+		fixedPointSpikingNeurons.clear();
+		referencePopulation.update(referenceSpikingNeurons);
+		singlePrecisionPopulation.update(singlePrecisionSpikingNeurons);
+		fixedPointPopulation.update(fixedPointSpikingNeurons);
+		ASSERT_EQ(referenceSpikingNeurons,singlePrecisionSpikingNeurons);
+		ASSERT_EQ(referenceSpikingNeurons,fixedPointSpikingNeurons);
+		
+		for(unsigned int i(0); i < n; i++)
+		{
+			ASSERT_NEAR(referencePopulation.getMembranePotential(i),singlePrecisionPopulation.getMembranePotential(i),1e-4);
+			ASSERT_NEAR(referencePopulation.getMembranePotential(i),fixedPointPopulation.getMembranePotential(i),1e-4);
+		}
+	}
+	EXPECT_GT(referencePopulation.getLastSpikeTime(0),0u);
+}
+
+TEST(connectivity, twoPasses) //tests if the connections counted in the first pass and added in the second one end up in the right rows of the table, sorted whatever the order they were added in
+{
+	Connectivity connections(3);
+	const std::vector<std::pair<unsigned int, unsigned int> > drawnConnections({{2,2},{0,2},{2,0},{2,1},{0,1}});
+	
+	for(const auto& connection: drawnConnections)
+	{
+		connections.countConnection(connection.first, connection.second);
+	}
+	connections.allocateTargets();
+	for(const auto& connection: drawnConnections)
+	{
+		connections.addConnection(connection.first, connection.second);
+	}
+	connections.freeze();
+	
+	Connectivity connectionsInTwoParts(3, 2); //the targets of the second part follow the ones of the first part, whatever the order in which the parts are added
+	for(size_t part(0); part < 2; part++)
+	{
+		connectionsInTwoParts.countConnection(2, part, part);
+	}
+	connectionsInTwoParts.allocateTargets();
+	for(size_t part(2); part > 0; part--)
+	{
+		connectionsInTwoParts.addConnection(2, part - 1, part - 1);
+	}
+	connectionsInTwoParts.freeze();
+	EXPECT_EQ(std::vector<std::uint32_t>({0,1}),std::vector<std::uint32_t>(connectionsInTwoParts.beginTargets(2),connectionsInTwoParts.endTargets(2)));
+	
+	EXPECT_EQ(drawnConnections.size(),connections.getNumberOfConnections());
+	EXPECT_EQ(std::vector<std::uint32_t>({1,2}),std::vector<std::uint32_t>(connections.beginTargets(0),connections.endTargets(0)));
+	EXPECT_EQ(0u,connections.getNumberOfTargets(1));
+	EXPECT_EQ(std::vector<std::uint32_t>({0,1,2}),std::vector<std::uint32_t>(connections.beginTargets(2),connections.endTargets(2)));
+}
+
+TEST(connectivity, parallelDrawing) //tests if the connections drawn by several threads are exactly the ones drawn by a single thread, and that they depend on their seed
+{
+	SimulationConfig config;
+	config.numberOfNeurons = 3000;
+	config.numberOfThreads = 1;
+	const std::shared_ptr<const Connectivity> connectionsOfOneThread(Network::createConnections(config));
+	config.numberOfThreads = 3;
+	const std::shared_ptr<const Connectivity> connectionsOfThreeThreads(Network::createConnections(config));
+	config.connectionSeed = 2;
+	const std::shared_ptr<const Connectivity> otherConnections(Network::createConnections(config));
+	
+	ASSERT_EQ(config.numberOfNeurons*(config.getNumberOfConnectionsFromExcitatoryNeurons() + config.getNumberOfConnectionsFromInhibitoryNeurons()),connectionsOfThreeThreads->getNumberOfConnections());
+	bool isSameAsOtherSeed(true);
+	for(unsigned int i(0); i < config.numberOfNeurons; i++)
+	{
+		const std::vector<std::uint32_t> targets(connectionsOfThreeThreads->beginTargets(i),connectionsOfThreeThreads->endTargets(i));
+		ASSERT_EQ(std::vector<std::uint32_t>(connectionsOfOneThread->beginTargets(i),connectionsOfOneThread->endTargets(i)),targets);
+		isSameAsOtherSeed = isSameAsOtherSeed and targets == std::vector<std::uint32_t>(otherConnections->beginTargets(i),otherConnections->endTargets(i));
+	}
+	EXPECT_FALSE(isSameAsOtherSeed);
+}
+
+TEST(hugePageAllocator, largeArrays) //tests if an array of at least one huge page starts on a huge page boundary and keeps its elements like an ordinary one, and that small arrays work as well, and that an array whose size overflows is refused
+{
+	std::vector<std::uint32_t, HugePageAllocator<std::uint32_t> > largeArray(HugePageAllocator<std::uint32_t>::HUGE_PAGE_SIZE/2, 7);
+	EXPECT_EQ(0u,reinterpret_cast<std::uintptr_t>(largeArray.data())%HugePageAllocator<std::uint32_t>::HUGE_PAGE_SIZE);
+	EXPECT_EQ(7u,largeArray.back());
+	largeArray.resize(10);
+	largeArray.shrink_to_fit();
+	EXPECT_EQ(std::vector<std::uint32_t>(10, 7),std::vector<std::uint32_t>(largeArray.begin(), largeArray.end()));
+	HugePageAllocator<std::uint64_t> allocator;
+	EXPECT_THROW(allocator.allocate(allocator.max_size() + 1), std::bad_array_new_length);	//the size in bytes would overflow
+}
+
+TEST(workerPool, workStealing) //tests if each task is run exactly once whatever the number of tasks, and that the workers that are done take over the tasks of a worker whose tasks last long
+{
+	WorkerPool workers(4);
+	for(size_t numberOfTasks: {0, 3, 1000})
+	{
+		std::vector<std::atomic<unsigned int> > numberOfRuns(numberOfTasks);
+		std::vector<size_t> workerOfTasks(numberOfTasks);
+		for(std::atomic<unsigned int>& runs: numberOfRuns)
+		{
+			runs = 0;
+		}
+		workers.runTasks(numberOfTasks, [&](size_t workerId, size_t task)
+		{
+			if(task < numberOfTasks/8)	//half the share of worker 0
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+			numberOfRuns[task]++;
+			workerOfTasks[task] = workerId;
+		});
+		for(size_t task(0); task < numberOfTasks; task++)
+		{
+			ASSERT_EQ(1u,numberOfRuns[task]);
+		}
+		if(numberOfTasks == 1000)
+		{
+			EXPECT_TRUE(std::any_of(workerOfTasks.begin(), workerOfTasks.begin() + numberOfTasks/4, [](size_t workerId){ return workerId != 0; }));
+		}
+	}
+}
+
+TEST(neuronalNetwork, numberOfThreads) //tests if for a given seed the network evolves exactly the same way whatever the number of threads that share its update
+{
+	constexpr unsigned int seed(42);
+	constexpr unsigned int duration(600);
+	Network singleThreadedNetwork(1, seed);
+	Network multiThreadedNetwork(3, seed);
+	EXPECT_EQ(3u,multiThreadedNetwork.getNumberOfThreads());
+	
+	for(auto network: {&singleThreadedNetwork, &multiThreadedNetwork})
+	{
+		network->setRatioJinoverJexG(3);	//the parameters of Brunel's graph A, the neurons spike early and a lot
+		network->setRatioVextOverVthr(2);
+		for(unsigned int t(0); t < duration; t++)
+		{
+			network->update();
+		}
+	}
+	
+	expectSameEvolution(singleThreadedNetwork, multiThreadedNetwork, TOTAL_NUMBER_OF_NEURONS_N, duration);
+}
+
+TEST(neuronalNetwork, batchedCommunication) //tests if a network whose threads exchange the spikes only after as many steps as the signal delay evolves exactly as one that exchanges them after each step, with the signal delay of the parameter file and with a different one set at runtime in a network sized at runtime
+{
+	SimulationConfig config;
+	config.seed = 7;
+	config.ratioJinOverJexG = 3;
+	config.ratioVextOverVthr = 2;
+	SimulationConfig runtimeConfig(config);
+	runtimeConfig.numberOfNeurons = 3000;
+	runtimeConfig.signalDelayD = 7;
+	runtimeConfig.seed = 3;
+	constexpr unsigned int duration(304); //the last round is incomplete with both signal delays
+	
+	for(SimulationConfig networkConfig: {config, runtimeConfig})
+	{
+		networkConfig.numberOfThreads = 1;
+		Network networkUpdatedStepByStep(networkConfig);
+		networkConfig.numberOfThreads = 2;
+		Network batchedNetwork(networkConfig);
+		networkUpdatedStepByStep.setBatchedCommunication(false);
+		for(unsigned int t(0); t < duration; t++)
+		{
+			networkUpdatedStepByStep.update();
+		}
+		batchedNetwork.update(duration);
+		
+		EXPECT_DOUBLE_EQ(networkConfig.getNumberOfConnectionsFromExcitatoryNeurons() + networkConfig.getNumberOfConnectionsFromInhibitoryNeurons(),batchedNetwork.getMeanNumberOfTargetsPerNeuron());
+		expectSameEvolution(networkUpdatedStepByStep, batchedNetwork, networkConfig.numberOfNeurons, duration);
+	}
+}
+
+TEST(simulationConfig, fileAndCommandLine) //tests if the parameters are read from a file, overridden by the command line, and if invalid ones are rejected
+{
+	{
+		std::ofstream configFile("simulationConfig_unitTest.txt");
+		configFile << "# a smaller network\n" << "numberOfNeurons = 5000\n" << "signalDelayD = 7 # in steps\n" << "ratioJinOverJexG = 5\n";
+	}
+	const char* arguments[] = {"neuron", "config=simulationConfig_unitTest.txt", "--ratioJinOverJexG=3"};
+	SimulationConfig config;
+	config.readCommandLine(3, arguments);
+	std::remove("simulationConfig_unitTest.txt");
+	EXPECT_EQ(5000u,config.numberOfNeurons);
+	EXPECT_EQ(7u,config.signalDelayD);
+	EXPECT_EQ(3,config.ratioJinOverJexG);
+	EXPECT_EQ(4000u,config.getNumberOfExcitatoryNeurons());
+	EXPECT_EQ(400u,config.getNumberOfConnectionsFromExcitatoryNeurons());
+	EXPECT_EQ(100u,config.getNumberOfConnectionsFromInhibitoryNeurons());
+	EXPECT_NO_THROW(config.validate());
+	
+	EXPECT_EQ(NUMBER_OF_EXCITATORY_NEURONS_Ne,SimulationConfig().getNumberOfExcitatoryNeurons()); //the defaults are the ones of the parameter file
+	EXPECT_EQ(NUMBER_OF_CONNECTIONS_FROM_INHIBITORY_NEURONS_Ci,SimulationConfig().getNumberOfConnectionsFromInhibitoryNeurons());
+	EXPECT_THROW(config.set("numberOfNeuron", "10"), std::invalid_argument);
+	EXPECT_THROW(config.set("signalDelayD", "1.5"), std::invalid_argument);
+	EXPECT_THROW(config.set("timeConstantTau", "20ms"), std::invalid_argument);
+	EXPECT_THROW(config.set("isEventDriven", "2"), std::invalid_argument);
+	config.set("isEventDriven", "1");
+	EXPECT_TRUE(config.isEventDriven);
+	config.set("sweepRatiosJinOverJexG", "3:5:0.5");
+	EXPECT_EQ(std::vector<double>({3, 3.5, 4, 4.5, 5}),config.sweepRatiosJinOverJexG);
+	config.set("sweepRatiosVextOverVthr", " 0.9, 2,4");
+	EXPECT_EQ(std::vector<double>({0.9, 2, 4}),config.sweepRatiosVextOverVthr);
+	EXPECT_THROW(config.set("sweepRatiosJinOverJexG", "5:3:1"), std::invalid_argument);
+	config.set("isCountingSpikes", "1");
+	config.set("numberOfNeurons", "100000");
+	config.set("ratioCOverNe", "1");	//80000 excitatory connections per neuron, more than 16 bits can count
+	EXPECT_THROW(config.validate(), std::invalid_argument);
+	config.set("ratioCOverNe", "0.1");
+	EXPECT_NO_THROW(config.validate());
+	config.set("timeConstantTau", "0");
+	EXPECT_THROW(config.validate(), std::invalid_argument);
+}
+
+TEST(neuronalNetwork, countedSpikes) //tests if a network whose ring buffers count the spikes evolves exactly as one that sums their amplitudes when the fixed point representation makes both exact, that a network whose input can overflow the fixed point representation is refused, and that only the two amplitudes can be counted
+{
+	SimulationConfig config;
+	config.numberOfNeurons = 2000;
+	config.seed = 9;
+	config.numberOfThreads = 2;
+	config.ratioJinOverJexG = 4.5;
+	config.ratioVextOverVthr = 2;
+	const std::shared_ptr<const Connectivity> connections(Network::createConnections(config));
+	BasicNetwork<FixedPointState> summingNetwork(config, connections);
+	config.isCountingSpikes = true;
+	BasicNetwork<FixedPointState> countingNetwork(config, connections);
+	constexpr unsigned int duration(300);
+	summingNetwork.update(duration);
+	countingNetwork.update(duration);
+	
+	expectSameEvolution(summingNetwork, countingNetwork, config.numberOfNeurons, duration);
+	
+	config.ratioJinOverJexG = 1000;	//160 + 1000*40 J don't fit into 32 bits
+	EXPECT_THROW(BasicNetwork<FixedPointState> overflowingNetwork(config, connections), std::invalid_argument);
+	EXPECT_NO_THROW(Network networkInDoublePrecision(config, connections));
+	config.ratioJinOverJexG = 4.5;
+	
+	config.ratioVextOverVthr = 0;
+	NeuronPopulation population(2, 1, config);
+	EXPECT_TRUE(population.isCountingSpikes());
+	EXPECT_THROW(population.receiveSpike(0, 0, 2*SPIKE_AMPLITUDE_J), std::invalid_argument);
+	population.setSpikeAmplitudes(2*SPIKE_AMPLITUDE_J, -SPIKE_AMPLITUDE_J);
+	population.receiveSpike(0, 0, 2*SPIKE_AMPLITUDE_J);
+	population.receiveSpike(0, 0, 2*SPIKE_AMPLITUDE_J);
+	population.receiveSpike(1, 0, -SPIKE_AMPLITUDE_J);
+	std::vector<unsigned int> spikingNeurons;
+	for(unsigned int t(0); t <= SIGNAL_DELAY_D; t++)
+	{
+		population.update(spikingNeurons);
+	}
+	EXPECT_DOUBLE_EQ(4*SPIKE_AMPLITUDE_J,population.getMembranePotential(0));
+	EXPECT_DOUBLE_EQ(-SPIKE_AMPLITUDE_J,population.getMembranePotential(1));
+}
+
+TEST(neuronalNetwork, deliveryStrategies) //tests if the networks whose threads deliver the spikes of their own neurons, atomically or through private counts, evolve exactly as the one whose threads deliver to their own neurons, and that they need counted spikes
+{
+	SimulationConfig config;
+	config.numberOfNeurons = 3000;
+	config.seed = 4;
+	config.numberOfThreads = 3;
+	config.ratioJinOverJexG = 4;
+	config.ratioVextOverVthr = 2;
+	EXPECT_THROW(Network(config).setDeliveryStrategy(Network::DeliveryStrategy::atomic), std::invalid_argument);
+	config.isCountingSpikes = true;
+	const std::shared_ptr<const Connectivity> connections(Network::createConnections(config));
+	constexpr unsigned int duration(200);
+	
+	for(bool isEventDriven: {false, true})
+	{
+		config.isEventDriven = isEventDriven;
+		Network referenceNetwork(config, connections);
+		referenceNetwork.update(duration);
+		for(Network::DeliveryStrategy strategy: {Network::DeliveryStrategy::atomic, Network::DeliveryStrategy::privatized, Network::DeliveryStrategy::automatic})
+		{
+			Network network(config, connections);
+			network.setDeliveryStrategy(strategy);
+			network.update(duration);
+			expectSameEvolution(referenceNetwork, network, config.numberOfNeurons, duration);
+		}
+	}
+}
+
+TEST(neuronalNetwork, bucketedDelivery) //tests if a network that sorts the spikes of busy steps into buckets of targets before delivering them evolves exactly as one that delivers them directly
+{
+	constexpr unsigned int seed(5);
+	constexpr unsigned int duration(300);
+	Network directNetwork(2, seed);
+	Network bucketedNetwork(2, seed);
+	bucketedNetwork.setBucketedDelivery(true);
+	
+	for(auto network: {&directNetwork, &bucketedNetwork})
+	{
+		network->setRatioJinoverJexG(3);	//synchronous regime, whose steps have hundreds of spikes
+		network->setRatioVextOverVthr(2);
+		network->update(duration);
+	}
+	
+	expectSameEvolution(directNetwork, bucketedNetwork, TOTAL_NUMBER_OF_NEURONS_N, duration);
+}
+
+TEST(neuronalNetwork, sharedConnections) //tests if networks sharing one table of connections evolve exactly as one that draws its own, and that a table of the wrong size is rejected
+{
+	SimulationConfig config;
+	config.numberOfNeurons = 2000;
+	config.seed = 7;
+	config.numberOfThreads = 1;
+	config.ratioJinOverJexG = 3;
+	config.ratioVextOverVthr = 2;
+	Network networkWithOwnConnections(config);
+	const std::shared_ptr<const Connectivity> connections(Network::createConnections(config));
+	Network firstNetwork(config, connections);
+	Network secondNetwork(config, firstNetwork.getConnections());
+	EXPECT_EQ(3,connections.use_count());
+	
+	constexpr unsigned int duration(200);
+	networkWithOwnConnections.update(duration);
+	firstNetwork.update(duration);
+	secondNetwork.update(duration);
+	expectSameEvolution(networkWithOwnConnections, firstNetwork, config.numberOfNeurons, duration);
+	expectSameEvolution(networkWithOwnConnections, secondNetwork, config.numberOfNeurons, duration);
+	
+	config.numberOfNeurons = 1000;
+	EXPECT_THROW(Network(config, connections), std::invalid_argument);
+}
+
+TEST(neuronalNetwork, recordingWindow) //tests if a recorder only receives the spikes of the steps of its window, bounds included, and as many as the network counts in that interval
+{
+	struct CountingRecorder : public SpikeRecorder
+	{
+		std::vector<unsigned int> times;
+		void record(unsigned int time, const unsigned int* firstNeuronId, const unsigned int* lastNeuronId) override
+		{
+			times.insert(times.end(), lastNeuronId - firstNeuronId, time);
+		}
+	};
+	SimulationConfig config;
+	config.numberOfNeurons = 2000;
+	config.seed = 13;
+	config.ratioJinOverJexG = 3;
+	config.ratioVextOverVthr = 2;
+	Network network(config);
+	CountingRecorder recorder;
+	constexpr unsigned int beginWindow(50), endWindow(121), duration(200); //the bounds don't coincide with the rounds
+	network.addSpikeRecorder(&recorder, beginWindow, endWindow);
+	network.update(duration);
+	
+	ASSERT_FALSE(recorder.times.empty());
+	EXPECT_LE(beginWindow,recorder.times.front());
+	EXPECT_GE(endWindow,recorder.times.back());
+	EXPECT_NEAR(network.getMeanSpikeRateInInterval(beginWindow,endWindow)*config.numberOfNeurons*(endWindow - beginWindow)*config.timeStepH*0.001,recorder.times.size(),0.001);
+}
+
+TEST(parameterSweep, parallelPoints) //tests if the points of a sweep simulated concurrently give the same statistics as a point simulated alone, and if these statistics agree with the network's spike rate
+{
+	SimulationConfig config;
+	config.numberOfNeurons = 2000;
+	config.seed = 5;
+	config.numberOfThreads = 2;
+	config.timeBeginMeasurement = 100;
+	config.finalTime = 400;
+	ParameterSweep sweep(config);
+	sweep.addGrid({3, 5}, {2, 4});
+	const std::vector<SweepResult>& results(sweep.run());
+	ASSERT_EQ(4u,results.size());
+	EXPECT_EQ(5,results[3].ratioJinOverJexG);
+	EXPECT_EQ(4,results[3].ratioVextOverVthr);
+	
+	const SweepResult result(ParameterSweep::simulate(config, 5, 2));
+	EXPECT_EQ(result.meanSpikeRate,results[2].meanSpikeRate);
+	EXPECT_EQ(result.coefficientOfVariationOfActivity,results[2].coefficientOfVariationOfActivity);
+	EXPECT_GT(result.meanSpikeRate,0);
+	EXPECT_GT(results[3].meanSpikeRate,results[2].meanSpikeRate); //a stronger background noise makes the neurons spike more often
+	EXPECT_LT(results[0].meanSpikeRate*0.99,results[0].meanSpikeRateOfExcitatoryNeurons*0.8 + results[0].meanSpikeRateOfInhibitoryNeurons*0.2);
+	EXPECT_GT(results[0].meanSpikeRate*1.01,results[0].meanSpikeRateOfExcitatoryNeurons*0.8 + results[0].meanSpikeRateOfInhibitoryNeurons*0.2);
+	EXPECT_GE(result.fractionOfSilentNeurons,0);
+	EXPECT_LE(result.fractionOfSilentNeurons,1);
+	
+	config.ratioJinOverJexG = 5;
+	config.ratioVextOverVthr = 2;
+	config.numberOfThreads = 1;
+	Network network(config);
+	network.update(config.finalTime);
+	EXPECT_DOUBLE_EQ(network.getMeanSpikeRateInInterval(config.timeBeginMeasurement,config.finalTime),result.meanSpikeRate); //the same spikes over the same steps, the final time is never reached
+}
+
+TEST(parameterSweep, reducedPrecision) //tests if the networks storing their state in single precision and in fixed point have the firing statistics of the one storing it in double precision, in the synchronous and in the asynchronous irregular regimes
+{
+	SimulationConfig config;
+	config.numberOfNeurons = 2000;
+	config.seed = 5;
+	config.timeBeginMeasurement = 200;
+	config.finalTime = 1200;
+	const std::shared_ptr<const Connectivity> connections(Network::createConnections(config));
+	
+	for(double ratioJinOverJexG: {3.0, 5.0})
+	{
+		const SweepResult reference(ParameterSweep::simulate(config, ratioJinOverJexG, 2, connections));
+		for(const SweepResult& result: {ParameterSweep::simulate<float>(config, ratioJinOverJexG, 2, connections), ParameterSweep::simulate<FixedPointState>(config, ratioJinOverJexG, 2, connections)})
+		{
+			EXPECT_NEAR(reference.meanSpikeRate,result.meanSpikeRate,0.05*reference.meanSpikeRate); //the trajectories diverge, the statistics don't
+			EXPECT_NEAR(reference.meanSpikeRateOfInhibitoryNeurons,result.meanSpikeRateOfInhibitoryNeurons,0.05*reference.meanSpikeRateOfInhibitoryNeurons);
+			EXPECT_NEAR(reference.standardDeviationOfSpikeRates,result.standardDeviationOfSpikeRates,0.1*reference.standardDeviationOfSpikeRates);
+			EXPECT_NEAR(reference.coefficientOfVariationOfActivity,result.coefficientOfVariationOfActivity,0.1*reference.coefficientOfVariationOfActivity);
+		}
+	}
+}
+
+TEST(asynchronousSpikeRecorder, backpressure) //tests if the writer thread hands the spikes over in the order of recording even when they don't fit into the channel, that the waiting is counted, and that an error of the recorder reaches the simulating thread
+{
+	struct StoringRecorder : public SpikeRecorder
+	{
+		std::vector<SpikeRecord> spikes;
+		unsigned int numberOfFlushes = 0;
+		void record(unsigned int time, const unsigned int* firstNeuronId, const unsigned int* lastNeuronId) override
+		{
+			for(const unsigned int* neuronId(firstNeuronId); neuronId != lastNeuronId; ++neuronId)
+			{
+				spikes.push_back({time, *neuronId});
+			}
+		}
+		void flush() override
+		{
+			numberOfFlushes++;
+		}
+	};
+	StoringRecorder* const storingRecorder(new StoringRecorder);
+	AsynchronousSpikeRecorder recorder(std::unique_ptr<SpikeRecorder>(storingRecorder), 10);	//rounded up to 16 spikes
+	std::vector<SpikeRecord> spikes;
+	for(unsigned int time(0); time < 200; time++)
+	{
+		std::vector<unsigned int> neuronIds((time*7)%50);	//up to three times the capacity
+		std::iota(neuronIds.begin(), neuronIds.end(), time);
+		recorder.record(time, neuronIds.data(), neuronIds.data() + neuronIds.size());
+		for(unsigned int neuronId: neuronIds)
+		{
+			spikes.push_back({time, neuronId});
+		}
+	}
+	recorder.flush();
+	
+	ASSERT_EQ(spikes.size(),storingRecorder->spikes.size());
+	for(size_t i(0); i < spikes.size(); i++)
+	{
+		ASSERT_EQ(spikes[i].time,storingRecorder->spikes[i].time);
+		ASSERT_EQ(spikes[i].neuronId,storingRecorder->spikes[i].neuronId);
+	}
+	EXPECT_EQ(1u,storingRecorder->numberOfFlushes);
+	const AsynchronousSpikeRecorder::BackpressureStatistics statistics(recorder.getStatistics());
+	EXPECT_EQ(spikes.size(),statistics.numberOfSpikes);
+	EXPECT_GT(statistics.numberOfStalls,0u);
+	EXPECT_EQ(16u,statistics.maximalOccupancy);
+	
+	struct FailingRecorder : public SpikeRecorder
+	{
+		void record(unsigned int, const unsigned int*, const unsigned int*) override
+		{
+			throw std::runtime_error("impossible to write");
+		}
+	};
+	AsynchronousSpikeRecorder failingRecorder(std::unique_ptr<SpikeRecorder>(new FailingRecorder), 16);
+	const unsigned int neuronId(3);
+	failingRecorder.record(0, &neuronId, &neuronId + 1);
+	EXPECT_THROW(failingRecorder.flush(), std::runtime_error);
+	
+	testing::internal::CaptureStderr();
+	{
+		AsynchronousSpikeRecorder unflushedRecorder(std::unique_ptr<SpikeRecorder>(new FailingRecorder), 16);
+		unflushedRecorder.record(0, &neuronId, &neuronId + 1);
+	}	//the error is reported when nobody has flushed the recorder
+	EXPECT_NE(std::string::npos,testing::internal::GetCapturedStderr().find("impossible to write"));
+}
+
+TEST(binarySpikeRecorder, streamAndReadBack) //tests if the spikes streamed to a binary file during the simulation are read back in the order of the steps and of the neurons' ids, and that there are as many as the network counted
+{
+	SimulationConfig config;
+	config.numberOfNeurons = 2000;
+	config.seed = 5;
+	config.ratioJinOverJexG = 3;
+	config.ratioVextOverVthr = 2;
+	Network network(config);
+	constexpr unsigned int duration(200);
+	unsigned long long numberOfSpikes(0);
+	{
+		BinarySpikeRecorder recorder("binarySpikeRecorder_unitTest.bin", config.numberOfNeurons, config.timeStepH);
+		network.addSpikeRecorder(&recorder);
+		network.update(duration);
+		network.removeSpikeRecorder(&recorder);
+		numberOfSpikes = recorder.getNumberOfSpikes();
+	}	//the recorder writes its buffer when it is destroyed
+	
+	BinarySpikeReader reader("binarySpikeRecorder_unitTest.bin");
+	EXPECT_EQ(config.numberOfNeurons,reader.getNumberOfNeurons());
+	EXPECT_EQ(config.timeStepH,reader.getTimeStep());
+	EXPECT_GT(numberOfSpikes,0u);
+	EXPECT_EQ(numberOfSpikes,reader.getNumberOfSpikes());
+	
+	SpikeRecord firstSpikes[3];
+	ASSERT_EQ(3u,reader.read(firstSpikes, 3));	//reads in chunks
+	std::vector<SpikeRecord> spikes(firstSpikes, firstSpikes + 3);
+	const std::vector<SpikeRecord> remainingSpikes(reader.readAll());
+	spikes.insert(spikes.end(), remainingSpikes.begin(), remainingSpikes.end());
+	EXPECT_EQ(0u,reader.read(firstSpikes, 3));
+	std::remove("binarySpikeRecorder_unitTest.bin");
+	
+	ASSERT_EQ(numberOfSpikes,spikes.size());
+	for(size_t i(0); i < spikes.size(); i++)
+	{
+		if(i > 0)
+		{
+			ASSERT_TRUE(spikes[i - 1].time < spikes[i].time or (spikes[i - 1].time == spikes[i].time and spikes[i - 1].neuronId < spikes[i].neuronId));
+		}
+		ASSERT_LT(spikes[i].neuronId,config.numberOfNeurons);
+		ASSERT_LT(spikes[i].time,duration);
+	}
+	EXPECT_NEAR(network.getMeanSpikeRateInInterval(0,duration)*config.numberOfNeurons*duration*config.timeStepH*0.001,numberOfSpikes,0.001); //the same spikes as the ones the neurons keep
+}
+
+TEST(spikeRaster, intervalQueries) //tests if the raster file written by its recorder is mapped back with the same spikes, which give the same mean spike rate in any interval
+{
+	SimulationConfig config;
+	config.numberOfNeurons = 2000;
+	config.seed = 11;
+	config.ratioJinOverJexG = 3;
+	config.ratioVextOverVthr = 2;
+	Network network(config);
+	constexpr unsigned int duration(300);
+	{
+		SpikeRasterRecorder recorder("spikeRaster_unitTest.bin", config.numberOfNeurons, config.timeStepH);
+		network.addSpikeRecorder(&recorder);
+		network.update(duration);
+		network.removeSpikeRecorder(&recorder);
+	}	//the recorder writes the raster file when it is destroyed
+	
+	{
+		SpikeRaster raster("spikeRaster_unitTest.bin");
+		EXPECT_EQ(config.numberOfNeurons,raster.getNumberOfNeurons());
+		EXPECT_EQ(config.timeStepH,raster.getTimeStep());
+		EXPECT_GT(raster.getNumberOfSpikes(),0u);
+		for(unsigned int beginInterval(0); beginInterval < duration; beginInterval += 70)
+		{
+			for(unsigned int endInterval(beginInterval + 1); endInterval <= duration; endInterval += 45)
+			{
+				EXPECT_EQ(network.getMeanSpikeRateInInterval(beginInterval,endInterval),raster.getMeanSpikeRateInInterval(beginInterval,endInterval));
+			}
+		}
+		for(unsigned int i(0); i < config.numberOfNeurons; i++)
+		{
+			ASSERT_TRUE(std::is_sorted(raster.beginSpikeTimes(i), raster.endSpikeTimes(i)));
+		}
+	}
+	std::remove("spikeRaster_unitTest.bin");
+	EXPECT_THROW(SpikeRaster("spikeRaster_unitTest.bin"), std::runtime_error);
+	
+	testing::internal::CaptureStderr();
+	{
+		SpikeRasterRecorder unwritableRecorder("noSuchDirectory/spikeRaster_unitTest.bin", config.numberOfNeurons, config.timeStepH);
+		EXPECT_THROW(unwritableRecorder.flush(), std::runtime_error);
+	}	//the error has been thrown, the destructor doesn't report it again
+	EXPECT_EQ("",testing::internal::GetCapturedStderr());
+	testing::internal::CaptureStderr();
+	{
+		SpikeRasterRecorder unwritableRecorder("noSuchDirectory/spikeRaster_unitTest.bin", config.numberOfNeurons, config.timeStepH);
+	}	//nobody flushed it, the destructor reports the error instead of throwing
+	EXPECT_NE(std::string::npos,testing::internal::GetCapturedStderr().find("noSuchDirectory/spikeRaster_unitTest.bin"));
+	
+	const std::vector<std::uint32_t> spikeTimes({3, 8, 5});
+	for(const std::vector<std::uint64_t>& firstSpikes: {std::vector<std::uint64_t>({0, 2, 3}), std::vector<std::uint64_t>({1, 2, 3}), std::vector<std::uint64_t>({0, 4, 3})})	//a valid index, one that doesn't start at zero and one that decreases
+	{
+		SpikeRaster::write("spikeRaster_unitTest.bin", config.timeStepH, firstSpikes, spikeTimes);
+		if(firstSpikes.front() == 0 and firstSpikes[1] <= firstSpikes[2])
+		{
+			EXPECT_EQ(3u,SpikeRaster("spikeRaster_unitTest.bin").getNumberOfSpikes());
+		}
+		else
+		{
+			EXPECT_THROW(SpikeRaster("spikeRaster_unitTest.bin"), std::runtime_error);
+		}
+	}
+	{
+		std::fstream file("spikeRaster_unitTest.bin", std::ios::binary | std::ios::in | std::ios::out);
+		const std::uint64_t hugeNumberOfSpikes((std::uint64_t(1) << 62) + spikeTimes.size());	//four bytes per spike wrap the expected size around to the actual one
+		file.seekp(SpikeRaster::HEADER_SIZE - sizeof(std::uint64_t));
+		file.write(reinterpret_cast<const char*>(&hugeNumberOfSpikes), sizeof(hugeNumberOfSpikes));
+	}
+	EXPECT_THROW(SpikeRaster("spikeRaster_unitTest.bin"), std::runtime_error);
+	std::remove("spikeRaster_unitTest.bin");
+}
+
+TEST(simulation, measurementInterval) //tests if the spike rate is measured in an interval the network is simulated until, and if an interval that ends before the current time of the network is refused
+{
+	SimulationConfig config;
+	config.numberOfNeurons = 1000;
+	config.seed = 2;
+	config.numberOfThreads = 1;
+	Simulation simulation(config);
+	EXPECT_GT(simulation.getMeanSpikeRateInInterval(3,2,0,200),0);
+	EXPECT_NO_THROW(simulation.getMeanSpikeRateInInterval(3,2,100,200));
+	EXPECT_THROW(simulation.getMeanSpikeRateInInterval(3,2,0,100), std::invalid_argument);
+}
+
 /*TEST(simulation, averageSpikeRate) //tests if the mean spike frequency is close to the one indicate in brunel's paper, seems to be too time consuming for a unit test. Therfore the comparison of these values is given when excecuting the program.
 {
 	Simulation simulation;
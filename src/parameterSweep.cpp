@@ -0,0 +1,103 @@
+#include "parameterSweep.hpp"
+#include "network.hpp"
+#include "spikeStatisticsRecorder.hpp"
+#include "workerPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+ParameterSweep::ParameterSweep(const SimulationConfig& config)
+:config(config)
+,results()
+{}
+
+void ParameterSweep::addPoint(double ratioJinOverJexG, double ratioVextOverVthr)
+{
+	SweepResult point = {};
+	point.ratioJinOverJexG = ratioJinOverJexG;
+	point.ratioVextOverVthr = ratioVextOverVthr;
+	results.push_back(point);
+}
+
+void ParameterSweep::addGrid(const vector<double>& ratiosJinOverJexG, const vector<double>& ratiosVextOverVthr)
+{
+	for(double ratioJinOverJexG: ratiosJinOverJexG)
+	{
+		for(double ratioVextOverVthr: ratiosVextOverVthr)
+		{
+			addPoint(ratioJinOverJexG, ratioVextOverVthr);
+		}
+	}
+}
+
+const vector<SweepResult>& ParameterSweep::run()
+{
+	if(results.empty())
+	{
+		return results;
+	}
+	const size_t numberOfThreads((config.numberOfThreads > 0) ? config.numberOfThreads : max(thread::hardware_concurrency(), 1u));
+	WorkerPool workers(min(numberOfThreads, results.size()));	//one network per thread rather than one network shared by all threads, the points don't need to communicate
+	const shared_ptr<const Connectivity> connections(Network::createConnections(config));	//the same for all points, the parameters swept don't change it
+	atomic<size_t> nextPoint(0);
+	workers.run([this, &nextPoint, &connections](size_t)
+	{
+		for(size_t point(nextPoint++); point < results.size(); point = nextPoint++)	//the points take more or less time depending on the spike rate, they are handed out one at a time
+		{
+			results[point] = simulate(config, results[point].ratioJinOverJexG, results[point].ratioVextOverVthr, connections);
+		}
+	});
+	return results;
+}
+
+void ParameterSweep::writeTable(const string& nameOfFile) const
+{
+	ofstream out(nameOfFile);
+	if(out.fail())
+	{
+		throw runtime_error("impossible to write in file " + nameOfFile);
+	}
+	out << "# g\tVext/Vthr\trate[Hz]\texcitatoryRate[Hz]\tinhibitoryRate[Hz]\tstdOfRates[Hz]\tsilentNeurons\tcvOfActivity\n";
+	for(const SweepResult& result: results)
+	{
+		out << result.ratioJinOverJexG << '\t' << result.ratioVextOverVthr << '\t' << result.meanSpikeRate << '\t' << result.meanSpikeRateOfExcitatoryNeurons << '\t'
+		    << result.meanSpikeRateOfInhibitoryNeurons << '\t' << result.standardDeviationOfSpikeRates << '\t' << result.fractionOfSilentNeurons << '\t' << result.coefficientOfVariationOfActivity << '\n';
+	}
+}
+
+template<typename State>
+SweepResult ParameterSweep::simulate(const SimulationConfig& config, double ratioJinOverJexG, double ratioVextOverVthr, shared_ptr<const Connectivity> connections)
+{
+	SimulationConfig configOfPoint(config);
+	configOfPoint.ratioJinOverJexG = ratioJinOverJexG;
+	configOfPoint.ratioVextOverVthr = ratioVextOverVthr;
+	configOfPoint.numberOfThreads = 1;
+	BasicNetwork<State> network(configOfPoint, connections ? connections : Network::createConnections(configOfPoint));
+	SpikeStatisticsRecorder statistics(configOfPoint.numberOfNeurons, configOfPoint.timeStepH);
+	network.addSpikeRecorder(&statistics, configOfPoint.timeBeginMeasurement, configOfPoint.finalTime);
+	network.update(configOfPoint.finalTime - network.getInternalTime());
+	network.removeSpikeRecorder(&statistics);
+	
+	SweepResult result;
+	result.ratioJinOverJexG = ratioJinOverJexG;
+	result.ratioVextOverVthr = ratioVextOverVthr;
+	result.meanSpikeRate = statistics.getMeanSpikeRate();
+	result.meanSpikeRateOfExcitatoryNeurons = statistics.getMeanSpikeRate(0, configOfPoint.getNumberOfExcitatoryNeurons());	//the excitatory neurons come first
+	result.meanSpikeRateOfInhibitoryNeurons = statistics.getMeanSpikeRate(configOfPoint.getNumberOfExcitatoryNeurons(), configOfPoint.numberOfNeurons);
+	result.standardDeviationOfSpikeRates = statistics.getStandardDeviationOfSpikeRates();
+	result.fractionOfSilentNeurons = statistics.getFractionOfSilentNeurons();
+	result.coefficientOfVariationOfActivity = statistics.getCoefficientOfVariationOfActivity();
+	return result;
+}
+
+template SweepResult ParameterSweep::simulate<double>(const SimulationConfig&, double, double, shared_ptr<const Connectivity>);
+template SweepResult ParameterSweep::simulate<float>(const SimulationConfig&, double, double, shared_ptr<const Connectivity>);
+template SweepResult ParameterSweep::simulate<FixedPointState>(const SimulationConfig&, double, double, shared_ptr<const Connectivity>);
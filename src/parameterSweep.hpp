@@ -0,0 +1,74 @@
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include "connectivity.hpp"
+#include "simulationConfig.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/** A point of Brunel's phase diagram and the state the network reaches there.
+ * @see ParameterSweep */
+struct SweepResult
+{
+	double ratioJinOverJexG; ///< The ratio of the spike amplitudes of the inhibitory and the excitatory neurons, g.
+	double ratioVextOverVthr; ///< The frequency of the background noise over the one needed to reach the threshold.
+	double meanSpikeRate; ///< The mean spike rate of all the neurons in the measurement interval, in Hz.
+	double meanSpikeRateOfExcitatoryNeurons; ///< The mean spike rate of the excitatory neurons, in Hz.
+	double meanSpikeRateOfInhibitoryNeurons; ///< The mean spike rate of the inhibitory neurons, in Hz.
+	double standardDeviationOfSpikeRates; ///< How much the spike rates of the neurons differ from one another, in Hz.
+	double fractionOfSilentNeurons; ///< The share of the neurons that didn't spike in the measurement interval.
+	double coefficientOfVariationOfActivity; ///< The standard deviation over the mean of the number of spikes per step, a measure of synchrony.
+};
+
+/** Simulates many points (g, Vext/Vthr) of Brunel's phase diagram in one process.
+ * Each point is an independent network with its own parameters, the points are shared among threads that each simulate one network at a time.
+   All the networks have the same size and connections and, if the configuration gives a seed, the same background noise, so that the points only differ by their parameters.
+   The connections are drawn once and shared by all the networks, which saves the time to draw them and the memory to store them for each point.
+ * @see SimulationConfig::sweepRatiosJinOverJexG */
+class ParameterSweep
+{
+	public:
+
+	/** A constructor.
+	 * @param config the parameters shared by all the points, valid according to SimulationConfig::validate(). Its number of threads is the number of networks simulated at the same time,
+	   its measurement interval goes from timeBeginMeasurement to finalTime */
+	explicit ParameterSweep(const SimulationConfig& config);
+
+	/** Adds a point to be simulated.
+	 * @param ratioJinOverJexG a double
+	 * @param ratioVextOverVthr a double */
+	void addPoint(double ratioJinOverJexG, double ratioVextOverVthr);
+
+	/** Adds all the combinations of the given values, the ratios Vext/Vthr varying fastest.
+	 * @param ratiosJinOverJexG a vector of doubles
+	 * @param ratiosVextOverVthr a vector of doubles */
+	void addGrid(const std::vector<double>& ratiosJinOverJexG, const std::vector<double>& ratiosVextOverVthr);
+
+	/** Simulates all the points that have been added.
+	 * @return the results, in the order the points were added */
+	const std::vector<SweepResult>& run();
+
+	/** Writes the results as a table, one line per point and one column per data member of SweepResult, preceded by a commented header.
+	 * @throw std::runtime_error if the file can't be written
+	 * @param nameOfFile a string */
+	void writeTable(const std::string& nameOfFile) const;
+
+	/** Simulates a single point in the calling thread.
+	 * @tparam State the type in which the neurons' potentials and inputs are stored, double, float or FixedPointState
+	 * @param config the parameters of the network, whose number of threads is ignored
+	 * @param ratioJinOverJexG a double
+	 * @param ratioVextOverVthr a double
+	 * @param connections the table of connections shared with the other points, drawn for this point alone if there is none
+	 * @return the state of the network in the measurement interval */
+	template<typename State = double>
+	static SweepResult simulate(const SimulationConfig& config, double ratioJinOverJexG, double ratioVextOverVthr, std::shared_ptr<const Connectivity> connections = nullptr);
+
+	private:
+
+	SimulationConfig config; ///< The parameters shared by all the points.
+	std::vector<SweepResult> results; ///< One entry per point, whose parameters are set when it is added and whose statistics are filled in by run().
+};
+
+#endif
@@ -5,7 +5,7 @@
 #include <cassert>
 #include <string>
 
-//Parameters
+//Parameters, the network simulation reads them at runtime from a SimulationConfig, which takes these values by default, see simulationConfig.hpp
 
 
 	//Time
@@ -17,8 +17,11 @@ constexpr unsigned int SIGNAL_DELAY_D(15); //delay that the signal undergoes bet
 //Fetch Data
 constexpr unsigned int TIME_BEGIN_PRINT_TO_TXT_FILE_BY_DEFAULT(10000); //simulation time interval in which the data gets printed to a text file, shouldn't between initial and final time of the simulation
 constexpr unsigned int TIME_END_PRINT_TO_TXT_FILE_BY_DEFAULT(12000);
+constexpr unsigned int TIME_BEGIN_MEASUREMENT_BY_DEFAULT(2000); //the mean spike rate is measured from this time on until the end of the simulation, once the network has settled
 
 const std::string NAME_OF_FILE("simulationData.txt"); //If not otherwise specified the data gets printed in a file of this name
+const std::string NAME_OF_SWEEP_FILE("sweepData.txt"); //the table of the mean spike rates of a parameter sweep, if not otherwise specified
+constexpr unsigned int SPIKE_CHANNEL_CAPACITY_BY_DEFAULT(1 << 20); //number of spikes the simulation can hand over to the thread writing a file before it has to wait for it, 8 MiB per file
 
 	//Current
 constexpr double EXTERNAL_CURRENT_BY_DEFAULT(0); //current applied to the neuron from the outside in piktoampere, by default zero, is not accounted for when simulating an entire network
@@ -43,6 +46,10 @@ constexpr double RATIO_C_OVER_N_E(0.1);//The ratio Ce/Ne is equal to the ratio C
 constexpr unsigned int NUMBER_OF_CONNECTIONS_FROM_EXCITATORY_NEURONS_Ce(NUMBER_OF_EXCITATORY_NEURONS_Ne*RATIO_C_OVER_N_E); // Ce = Cext, the number of connections from excitatory from the rest of the brain that fire arbitrarily at a given rate
 constexpr unsigned int NUMBER_OF_CONNECTIONS_FROM_INHIBITORY_NEURONS_Ci(NUMBER_OF_INHIBITORY_NEURONS_Ni*RATIO_C_OVER_N_E);
 
+constexpr unsigned int NUMBER_OF_THREADS_BY_DEFAULT(0); //number of threads sharing the update of a network, zero stands for as many as the hardware supports, the results don't depend on it
+constexpr unsigned int CONNECTION_SEED_BY_DEFAULT(1); //seed of the random connections, the same network is drawn at each run unless it is changed
+constexpr unsigned int NOISE_SEED_BY_DEFAULT(1); //seed of the background noise of a single neuron, see Neuron, the same noise is drawn at each run unless it is changed
+
 
 //Membrane Potential
 constexpr double INITIAL_MEMBRANE_POTENTIAL(0);	//initial membrane portential in mV
@@ -0,0 +1,81 @@
+#include "poissonSampler.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+PoissonSampler::PoissonSampler(double mean)
+:mean(mean)
+{
+	assert(mean >= 0);
+	const double NEGLIGIBLE_PROBABILITY(ldexp(1.0, -40));
+
+	//the probabilities of the values 0, 1, 2 ... until the remaining ones are negligible
+	vector<double> probabilities;
+	double cumulativeProbability(0);
+	for(unsigned int k(0); probabilities.empty() or k < mean or 1 - cumulativeProbability >= NEGLIGIBLE_PROBABILITY; k++)
+	{
+		const double probability((mean > 0) ? exp(k*log(mean) - mean - lgamma(k + 1.0)) : (k == 0 ? 1 : 0));	//computed in logarithms, which doesn't underflow for large means
+		probabilities.push_back(probability);
+		cumulativeProbability += probability;
+	}
+	probabilities.back() += max(0.0, 1 - cumulativeProbability);	//the neglected values are counted as the largest one
+
+	//a power of two of columns, at least two so that shifting the random number is always defined
+	unsigned int numberOfBitsOfColumn(1);
+	while((size_t(1) << numberOfBitsOfColumn) < probabilities.size())
+	{
+		numberOfBitsOfColumn++;
+	}
+	const size_t numberOfColumns(size_t(1) << numberOfBitsOfColumn);
+	numberOfBitsOfComparison = 32 - numberOfBitsOfColumn;
+	comparedBitsMask = (uint32_t(1) << numberOfBitsOfComparison) - 1;
+
+	//Vose's construction: each column is filled up to one with its own probability and the excess of a larger one
+	vector<double> scaledProbabilities(numberOfColumns, 0);
+	for(size_t k(0); k < probabilities.size(); k++)
+	{
+		scaledProbabilities[k] = probabilities[k]*numberOfColumns;
+	}
+	vector<size_t> smallColumns;
+	vector<size_t> largeColumns;
+	for(size_t k(0); k < numberOfColumns; k++)
+	{
+		(scaledProbabilities[k] < 1 ? smallColumns : largeColumns).push_back(k);
+	}
+
+	vector<double> shares(numberOfColumns, 1);
+	aliases.resize(numberOfColumns);
+	for(size_t k(0); k < numberOfColumns; k++)
+	{
+		aliases[k] = k;
+	}
+	while(not smallColumns.empty() and not largeColumns.empty())
+	{
+		const size_t smallColumn(smallColumns.back());
+		const size_t largeColumn(largeColumns.back());
+		smallColumns.pop_back();
+		shares[smallColumn] = scaledProbabilities[smallColumn];
+		aliases[smallColumn] = largeColumn;
+		scaledProbabilities[largeColumn] -= 1 - scaledProbabilities[smallColumn];
+		if(scaledProbabilities[largeColumn] < 1)
+		{
+			largeColumns.pop_back();
+			smallColumns.push_back(largeColumn);
+		}
+	}	//the columns left over are full up to rounding errors and keep a share of one
+
+	const double scale(ldexp(1.0, numberOfBitsOfComparison));
+	thresholds.resize(numberOfColumns);
+	for(size_t k(0); k < numberOfColumns; k++)
+	{
+		thresholds[k] = static_cast<uint32_t>(min(scale, max(0.0, round(shares[k]*scale))));
+	}
+}
+
+double PoissonSampler::getMean() const
+{ return mean; }
@@ -0,0 +1,62 @@
+#ifndef POISSON_SAMPLER_H
+#define POISSON_SAMPLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** A sampler of a poisson distribution of fixed mean, turning a single random 32 bit number into a sample.
+ * It is meant for the background noise, whose mean stays the same during a whole simulation and is small (about 0.5 to 2 spikes per step).
+   When the sampler is created the distribution is tabulated once for the alias method (Walker, Vose): the highest bits of the random number choose a column of the table,
+   the remaining ones are compared with the column's threshold to decide between the column's own value and its alias. A sample thus costs a table lookup and a comparison, without any branch.
+   The values whose probability is below 2^-40 are left out of the table.
+ * @see NeuronPopulation::addBackgroundNoise */
+class PoissonSampler
+{
+	public:
+
+	/** A constructor.
+	 * Tabulates the poisson distribution of given mean.
+	 * @param mean a double, zero or positive */
+	explicit PoissonSampler(double mean);
+
+	/// A getter for the mean of the distribution.
+	double getMean() const;
+
+	/** Turns a random number into a sample of the distribution.
+	 * Defined in the header so that it can be inlined in the update loops.
+	 * @param randomNumber a uniformly distributed 32 bit number
+	 * @return a sample, an unsigned int */
+	unsigned int sample(std::uint32_t randomNumber) const
+	{
+		const std::uint32_t column(randomNumber >> numberOfBitsOfComparison);
+		const std::uint32_t comparedBits(randomNumber & comparedBitsMask);
+		return (comparedBits < thresholds[column]) ? column : aliases[column];
+	}
+
+	/** Draws a sample for each random number and adds it, multiplied by a weight, to the corresponding entry of an array, which allows to draw the noise of a whole population in a single call.
+	 * @tparam T the type of the entries, double, float or an integer
+	 * @param randomNumbers a pointer to the first of the uniformly distributed 32 bit numbers
+	 * @param numberOfSamples a size_t
+	 * @param weight a double, converted to the type of the entries
+	 * @param sums a pointer to the first entry of the array to which the weighted samples are added */
+	template<typename T>
+	void addSamples(const std::uint32_t* randomNumbers, size_t numberOfSamples, double weight, T* sums) const
+	{
+		const T weightOfSamples(static_cast<T>(weight));
+		for(size_t i(0); i < numberOfSamples; i++)
+		{
+			sums[i] += weightOfSamples*static_cast<T>(sample(randomNumbers[i]));
+		}
+	}
+
+	private:
+
+	double mean; ///< The mean of the distribution, a double.
+	unsigned int numberOfBitsOfComparison; ///< The number of low bits of the random number that are compared with the threshold, the others choose the column.
+	std::uint32_t comparedBitsMask; ///< The mask extracting the compared bits.
+	std::vector<std::uint32_t> thresholds; ///< For each column, the compared bits below which the sample is the column itself.
+	std::vector<std::uint32_t> aliases; ///< For each column, the sample if the compared bits are not below the threshold.
+};
+
+#endif
@@ -1,21 +1,38 @@
-#include "inhibitoryNeuron.hpp"
 #include "network.hpp"
-#include "neuron.hpp"
 #include "parameters.hpp"
 #include "simulation.hpp"
+#include "binarySpikeRecorder.hpp"
+#include "spikeRasterRecorder.hpp"
+#include "textSpikeRecorder.hpp"
 
+#include <cassert>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <iostream>
 
 
 using namespace std;
 
-unsigned int Simulation::timeBeginPrintToTxtFile(TIME_BEGIN_PRINT_TO_TXT_FILE_BY_DEFAULT);
-unsigned int Simulation::timeEndPrintToTxtFile(TIME_END_PRINT_TO_TXT_FILE_BY_DEFAULT);
-
-Simulation::Simulation()
-:network()
-{}
+Simulation::Simulation(const SimulationConfig& config)
+:config(config)
+,network(config)
+{
+	if(not config.nameOfSpikeFile.empty())
+	{
+		spikeRecorders.emplace_back(new AsynchronousSpikeRecorder(unique_ptr<SpikeRecorder>(new BinarySpikeRecorder(config.nameOfSpikeFile, config.numberOfNeurons, config.timeStepH)), config.spikeChannelCapacity));
+		namesOfRecordedFiles.push_back(config.nameOfSpikeFile);
+	}
+	if(not config.nameOfRasterFile.empty())
+	{
+		spikeRecorders.emplace_back(new AsynchronousSpikeRecorder(unique_ptr<SpikeRecorder>(new SpikeRasterRecorder(config.nameOfRasterFile, config.numberOfNeurons, config.timeStepH)), config.spikeChannelCapacity));
+		namesOfRecordedFiles.push_back(config.nameOfRasterFile);
+	}
+	for(auto& recorder: spikeRecorders)
+	{
+		network.addSpikeRecorder(recorder.get());
+	}
+}
 
 int Simulation::runBrunel()
 {
@@ -25,74 +42,81 @@ int Simulation::runBrunel()
 	
 	switch(readKeyboard)
 	{
-		case 'A':   printDataForBrunelFigureToFile(3,2,5000,6000);
-					return system("python ../src/pyscript.py");
+		case 'A':   printDataForBrunelFigureToFile(3,2,5000,6000,config.nameOfFile);
+					break;
 					
 		case 'B':	cout << "The neurons have a mean firing frequency of " << printDataForBrunelFigureToFileWithMeanSpikingRate(6,4) <<
 					" Hz." << endl << "The corresponding value for this setting from Brunel is in Theory: 55.8 Hz and in Simulation: 60.7 Hz." << endl;
-					return system("python ../src/pyscript.py");	
+					break;
 		case 'C':	cout << "The neurons have a mean firing frequency of " << printDataForBrunelFigureToFileWithMeanSpikingRate(5,2) <<
 					" Hz." << endl << "The corresponding value for this setting from Brunel is in Theory: 38.0 Hz and in Simulation: 37.7 Hz." << endl;
-					return system("python ../src/pyscript.py"); 
+					break;
 		case 'D':	cout << "The neurons have a mean firing frequency of " << printDataForBrunelFigureToFileWithMeanSpikingRate(4.5,0.9) <<
 					" Hz." << endl << "The corresponding value for this setting from Brunel is in Theory: 6.5 Hz and in Simulation: 5.5 Hz." << endl;
-					return system("python ../src/pyscript.py");
+					break;
 		default: cout << "You did not chose a graph to be generated." << endl; return 1;
 	}
+	for(auto& recorder: spikeRecorders)	//the files are complete before anyone reads them, and an error of a writer thread reaches main()
+	{
+		recorder->flush();
+	}
+	return system("python ../src/pyscript.py");
 }
 	
-unsigned int Simulation::getTimeBeginPrintToTxtFile()
-{
-	return timeBeginPrintToTxtFile;
-}
-	
-unsigned int Simulation::getTimeEndPrintToTxtFile()
-{
-	return timeEndPrintToTxtFile;
-}
-
 double Simulation::getMeanSpikeRateInInterval(double ratioJinoverJexG, double ratioVextOverVthr, unsigned int timeBeginMeasurement, unsigned int timeEndMeasurement)
 	{
-		InhibitoryNeuron::setRatioJinoverJexG(ratioJinoverJexG);
-		Neuron::setRatioVextOverVthr(ratioVextOverVthr);
-		
-		unsigned int simulationTime(INITIAL_TIME);	//initializing the simulation time
-		
-		while (simulationTime < timeEndMeasurement)	// "<" because the time scale is defined as each interval step going from [t to t+h), t+h isn't in the interval otherwise I would account twice for certain points in time
+		if(timeEndMeasurement < network.getInternalTime())
 		{
-			network.update();
-			simulationTime ++;
+			throw invalid_argument("the interval of the measurement ends before the current time of the network, which was simulated with other parameters");
 		}
+		network.setRatioJinoverJexG(ratioJinoverJexG);
+		network.setRatioVextOverVthr(ratioVextOverVthr);
+		
+		run(timeEndMeasurement);
 		return network.getMeanSpikeRateInInterval(timeBeginMeasurement,timeEndMeasurement);
 	}
 	
 		
 void Simulation::printDataForBrunelFigureToFile(double ratioJinoverJexG, double ratioVextOverVthr, unsigned int timeBeginMeasurement , unsigned int timeEndMeasurement, const string& nameOfFile)
 {
-	InhibitoryNeuron::setRatioJinoverJexG(ratioJinoverJexG);
-	Neuron::setRatioVextOverVthr(ratioVextOverVthr);
-	timeBeginPrintToTxtFile = timeBeginMeasurement;
-	timeEndPrintToTxtFile = timeEndMeasurement;
+	network.setRatioJinoverJexG(ratioJinoverJexG);
+	network.setRatioVextOverVthr(ratioVextOverVthr);
+	AsynchronousSpikeRecorder textRecorder(unique_ptr<SpikeRecorder>(new TextSpikeRecorder(nameOfFile, config.timeStepH)), config.spikeChannelCapacity);	//the text is formatted by the writer thread while the network is being simulated
+	network.addSpikeRecorder(&textRecorder, timeBeginMeasurement, timeEndMeasurement);
 	run(timeEndMeasurement);
-	network.printSimulationDataWithinTimeInterval(nameOfFile);
+	network.removeSpikeRecorder(&textRecorder);
+	textRecorder.flush();	//the file is complete for pyscript.py
+	printBackpressure(textRecorder, nameOfFile);
 }
 	
 double Simulation::printDataForBrunelFigureToFileWithMeanSpikingRate(double ratioJinoverJexG, double ratioVextOverVthr)
 {
-	printDataForBrunelFigureToFile(ratioJinoverJexG,ratioVextOverVthr);
-	return network.getMeanSpikeRateInInterval(2000,12000);
+	printDataForBrunelFigureToFile(ratioJinoverJexG,ratioVextOverVthr,config.timeBeginPrintToTxtFile,config.timeEndPrintToTxtFile,config.nameOfFile);
+	run(config.finalTime);	//the spike rate may be measured beyond the printed interval
+	return network.getMeanSpikeRateInInterval(config.timeBeginMeasurement,config.finalTime);
 }
 	
 void Simulation::run(unsigned int durationOfSimulation)
 {
-	unsigned int simulationTime(INITIAL_TIME);	//initializing the simulation time
-	
-	cout << "The desired simulation gets excecuted. This can take a moment. Please be patient!" << endl;
-	
-	while (simulationTime < durationOfSimulation)	// "<" because the time scale is defined as each interval step going from [t to t+h), t+h isn't in the interval otherwise I would account twice for certain points in time
+	assert(durationOfSimulation >= network.getInternalTime());
+	if(durationOfSimulation > network.getInternalTime())
+	{
+		cout << "The desired simulation gets excecuted. This can take a moment. Please be patient!" << endl;
+		network.update(durationOfSimulation - network.getInternalTime());	//the time scale is defined as each interval step going from [t to t+h), t+h isn't in the interval otherwise I would account twice for certain points in time
+	}
+	for(size_t i(0); i < spikeRecorders.size(); i++)
+	{
+		printBackpressure(*spikeRecorders[i], namesOfRecordedFiles[i]);
+	}
+}
+
+void Simulation::printBackpressure(const AsynchronousSpikeRecorder& recorder, const string& nameOfFile) const
+{
+	const AsynchronousSpikeRecorder::BackpressureStatistics statistics(recorder.getStatistics());
+	if(statistics.numberOfStalls > 0)
 	{
-		network.update();
-		simulationTime ++;
+		cout << "The simulation waited " << statistics.numberOfStalls << " times, " << statistics.stallTime << " s in total, for the spikes to be written to " << nameOfFile
+		     << ". A larger spikeChannelCapacity than " << config.spikeChannelCapacity << " avoids it." << endl;
 	}
 }
 	
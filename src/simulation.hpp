@@ -1,35 +1,35 @@
 #ifndef SIMULATION_H
 #define SIMULATION_H
 
+#include "asynchronousSpikeRecorder.hpp"
 #include "parameters.hpp"
 #include "network.hpp"
+#include "simulationConfig.hpp"
 
+#include <memory>
 #include <string>
+#include <vector>
 
 /** The class simulation allows to specify the simulations precise parameter and makes running the simulation easier for the user.*/
 class Simulation
 {
 	public:
 	
-	/// A constructor.
-	Simulation();
+	/** A constructor.
+	 * @param config the parameters of the simulation, by default the ones of the parameter file */
+	explicit Simulation(const SimulationConfig& config = SimulationConfig());
 	
 	/**A function that allows to chose one of the four graphs from Brunel that is then reproduced.
 	 * Once the graph is chosen, the simulation gets run for the desired parameters. Then a window opens and displays the scatter diagram. If it is closed, the histogram appears. If none of the graphs is chosen, the program stops.
 	   For scenarios B, C and D the mean firing rate of the neurons is computed and a reference value from Brunel is given.
-	 * @see int main()*/
+	 * The binary and raster files, if any, are flushed before the figure is drawn.
+	 * @see int main()
+	 * @throw std::runtime_error if a spike file can't be written */
 	int runBrunel();
 	
-	///A getter of the simulation time from when on the spikes get printed to the text file.
-	/**@see Network::getIteratorToBeginInterval(unsigned int neuronId)*/
-	static unsigned int getTimeBeginPrintToTxtFile();// Due to the (too) complicated class architecture.
-	///A getter of the simulation time up to when the spikes get printed to the text file.
-	/**@see Network::getIteratorToEndInterval(unsigned int neuronId)*/
-	static unsigned int getTimeEndPrintToTxtFile();
-	
-
 	/** A method allowing to specify the necessary simulation parameters (but not the interval) in order to obtain the data required the mean firing rate of the simulation's neurons in a given interval. Seems to be too time consuming to work out in a unitTest.
 	 * @see neuron_unitTest.cpp
+	 * @throw std::invalid_argument if timeEndMeasurement is before the current time of the network
 	 * @param ratioJinoverJexG a double
 	 * @param ratioVextOverVthr a double
 	 * @param timeBeginMeasurement an unsigned int
@@ -38,12 +38,13 @@ class Simulation
 	
 	private:
 	
-	static unsigned int timeBeginPrintToTxtFile;///< A static parameter specifying from when on the spikes get printed to the text file, an unsigned int.
-	static unsigned int timeEndPrintToTxtFile;///< A static parameter specifying up to when the spikes get printed to the text file, an unsigned int.
-	
+	SimulationConfig config;///< The parameters of the simulation, read at startup.
 	Network network;///< The ensemble of neurons that is being studied.	
+	std::vector<std::unique_ptr<AsynchronousSpikeRecorder> > spikeRecorders;///< The recorders of the binary and raster files named by the configuration, if any, recording the whole simulation, each file being written by a thread of its own.
+	std::vector<std::string> namesOfRecordedFiles;///< The names of the files of spikeRecorders, in the same order.
 	
 	/**A method allowing to specify the necessary simulation parameters in order to obtain the data required for the reproduction of Brunel's figures.
+	 * The spikes of the interval are printed to the text file while the network is being simulated.
 	 * @see runBrunel()
 	 * @see  printDataForBrunelFigureToFileWithMeanSpikingRate
 	 * @param ratioJinoverJexG a double
@@ -51,18 +52,23 @@ class Simulation
 	 * @param timeBeginMeasurement an unsigned int
 	 * @param timeEndMeasurement an unsigned int
 	 * @param nameOfFile a string */
-	void printDataForBrunelFigureToFile(double ratioJinoverJexG, double ratioVextOverVthr, unsigned int timeBeginMeasurement = TIME_BEGIN_PRINT_TO_TXT_FILE_BY_DEFAULT, unsigned int timeEndMeasurement = TIME_END_PRINT_TO_TXT_FILE_BY_DEFAULT, const std::string& nameOfFile = NAME_OF_FILE);
+	void printDataForBrunelFigureToFile(double ratioJinoverJexG, double ratioVextOverVthr, unsigned int timeBeginMeasurement, unsigned int timeEndMeasurement, const std::string& nameOfFile);
 	
-	/**A method allowing to specify the necessary simulation parameters (but not the interval) in order to obtain the data required for the reproduction of Brunel's figures and ,as a test, the mean firing frequency of the simulation's neurons.
+	/**A method allowing to specify the necessary simulation parameters (but not the interval, which is the one of the configuration) in order to obtain the data required for the reproduction of Brunel's figures and ,as a test, the mean firing frequency of the simulation's neurons.
 	 * @see runBrunel()
 	 * @param ratioJinoverJexG a double
 	 * @param ratioVextOverVthr a double */
 	double printDataForBrunelFigureToFileWithMeanSpikingRate(double ratioJinoverJexG, double ratioVextOverVthr);
 	
-	/**An auxiliary method in order to modularize the code
+	/**An auxiliary method in order to modularize the code, updates the network until a given time.
 	 * @see printDataForBrunelFigureToFile()
-	 * @param durationOfSimulation a unsigned integer */
-	void run(unsigned int durationOfSimulation = FINAL_TIME);
+	 * @param durationOfSimulation the time at which the simulation stops, an unsigned integer */
+	void run(unsigned int durationOfSimulation);
+	
+	/**An auxiliary method that tells the user if the simulation had to wait for the thread writing a file, which a larger spikeChannelCapacity avoids.
+	 * @param recorder the recorder of the file
+	 * @param nameOfFile a string */
+	void printBackpressure(const AsynchronousSpikeRecorder& recorder, const std::string& nameOfFile) const;
 };
 
 
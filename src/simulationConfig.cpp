@@ -0,0 +1,275 @@
+#include "simulationConfig.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+	/** Reads a number written with nothing else but surrounding blanks, a flag being written 0 or 1.
+	 * @throw std::invalid_argument if the text isn't a number of the expected type
+	 * @param text a string
+	 * @param name the name of the parameter, for the error message */
+	template<typename Number>
+	Number parse(const string& text, const string& name)
+	{
+		size_t numberOfCharactersRead(0);
+		double value(0);
+		try
+		{
+			value = stod(text, &numberOfCharactersRead);
+		}
+		catch(const exception&)
+		{
+			numberOfCharactersRead = 0;
+		}
+		const bool isWhole(numberOfCharactersRead > 0 and text.find_first_not_of(" \t\r", numberOfCharactersRead) == string::npos);
+		const double maximalValue(is_same<Number, bool>::value ? 1 : 4294967295.0);
+		const bool isRepresentable(is_floating_point<Number>::value or (value >= 0 and value <= maximalValue and value == floor(value)));
+		if(not isWhole or not isRepresentable)
+		{
+			throw invalid_argument("invalid value \"" + text + "\" for the parameter " + name);
+		}
+		return static_cast<Number>(value);
+	}
+
+	/// Removes the blanks surrounding a text.
+	string trim(const string& text)
+	{
+		const size_t first(text.find_first_not_of(" \t\r"));
+		return (first == string::npos) ? string() : text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+	}
+
+	/** Reads a list of numbers, either written one after the other separated by commas or as a range "first:last:step" whose last value is included if the steps reach it.
+	 * @throw std::invalid_argument if the text isn't such a list
+	 * @param text a string
+	 * @param name the name of the parameter, for the error message */
+	vector<double> parseList(const string& text, const string& name)
+	{
+		vector<double> values;
+		const size_t firstColon(text.find(':'));
+		if(firstColon != string::npos)
+		{
+			const size_t secondColon(text.find(':', firstColon + 1));
+			if(secondColon == string::npos)
+			{
+				throw invalid_argument("invalid range \"" + text + "\" for the parameter " + name + ", expected first:last:step");
+			}
+			const double first(parse<double>(text.substr(0, firstColon), name));
+			const double last(parse<double>(text.substr(firstColon + 1, secondColon - firstColon - 1), name));
+			const double step(parse<double>(text.substr(secondColon + 1), name));
+			if(not (step > 0) or first > last)
+			{
+				throw invalid_argument("invalid range \"" + text + "\" for the parameter " + name + ", expected first:last:step");
+			}
+			for(unsigned int i(0); first + i*step <= last + 1e-9*step; i++)	//tolerates the rounding of the steps, 0:1:0.1 ends with 1
+			{
+				values.push_back(first + i*step);
+			}
+		}
+		else
+		{
+			istringstream in(text);
+			string value;
+			while(getline(in, value, ','))
+			{
+				values.push_back(parse<double>(trim(value), name));
+			}
+		}
+		return values;
+	}
+}
+
+void SimulationConfig::readFile(const string& nameOfConfigFile)
+{
+	ifstream in(nameOfConfigFile);
+	if(in.fail())
+	{
+		throw invalid_argument("impossible to read the configuration file " + nameOfConfigFile);
+	}
+
+	string line;
+	for(unsigned int lineNumber(1); getline(in, line); lineNumber++)
+	{
+		line = trim(line.substr(0, line.find('#')));
+		if(line.empty())
+		{
+			continue;
+		}
+		const size_t equalSign(line.find('='));
+		if(equalSign == string::npos)
+		{
+			throw invalid_argument(nameOfConfigFile + ", line " + to_string(lineNumber) + ": expected \"name = value\"");
+		}
+		set(trim(line.substr(0, equalSign)), trim(line.substr(equalSign + 1)));
+	}
+}
+
+void SimulationConfig::readCommandLine(int argc, const char* const argv[])
+{
+	for(int i(1); i < argc; i++)
+	{
+		string argument(argv[i]);
+		if(argument.compare(0, 2, "--") == 0)	//tolerates the usual option syntax
+		{
+			argument.erase(0, 2);
+		}
+		const size_t equalSign(argument.find('='));
+		if(equalSign == string::npos)
+		{
+			throw invalid_argument("expected name=value instead of \"" + argument + "\"");
+		}
+		const string name(argument.substr(0, equalSign));
+		const string value(argument.substr(equalSign + 1));
+		if(name == "config")
+		{
+			readFile(value);
+		}
+		else
+		{
+			set(name, value);
+		}
+	}
+}
+
+void SimulationConfig::set(const string& name, const string& value)
+{
+	static const map<string, unsigned int SimulationConfig::*> unsignedParameters = {
+		{"numberOfNeurons", &SimulationConfig::numberOfNeurons},
+		{"numberOfThreads", &SimulationConfig::numberOfThreads},
+		{"seed", &SimulationConfig::seed},
+		{"connectionSeed", &SimulationConfig::connectionSeed},
+		{"signalDelayD", &SimulationConfig::signalDelayD},
+		{"refractionPeriod", &SimulationConfig::refractionPeriod},
+		{"finalTime", &SimulationConfig::finalTime},
+		{"timeBeginMeasurement", &SimulationConfig::timeBeginMeasurement},
+		{"timeBeginPrintToTxtFile", &SimulationConfig::timeBeginPrintToTxtFile},
+		{"timeEndPrintToTxtFile", &SimulationConfig::timeEndPrintToTxtFile},
+		{"spikeChannelCapacity", &SimulationConfig::spikeChannelCapacity}};
+	static const map<string, double SimulationConfig::*> doubleParameters = {
+		{"percentExcitatoryNeurons", &SimulationConfig::percentExcitatoryNeurons},
+		{"ratioCOverNe", &SimulationConfig::ratioCOverNe},
+		{"timeStepH", &SimulationConfig::timeStepH},
+		{"timeConstantTau", &SimulationConfig::timeConstantTau},
+		{"membranePotentialThreshold", &SimulationConfig::membranePotentialThreshold},
+		{"resetMembranePotential", &SimulationConfig::resetMembranePotential},
+		{"initialMembranePotential", &SimulationConfig::initialMembranePotential},
+		{"spikeAmplitudeJExcitatory", &SimulationConfig::spikeAmplitudeJExcitatory},
+		{"ratioJinOverJexG", &SimulationConfig::ratioJinOverJexG},
+		{"ratioVextOverVthr", &SimulationConfig::ratioVextOverVthr}};
+
+	if(unsignedParameters.count(name) > 0)
+	{
+		this->*unsignedParameters.at(name) = parse<unsigned int>(value, name);
+	}
+	else if(doubleParameters.count(name) > 0)
+	{
+		this->*doubleParameters.at(name) = parse<double>(value, name);
+	}
+	else if(name == "isEventDriven")
+	{
+		isEventDriven = parse<bool>(value, name);
+	}
+	else if(name == "isCountingSpikes")
+	{
+		isCountingSpikes = parse<bool>(value, name);
+	}
+	else if(name == "nameOfFile")
+	{
+		nameOfFile = value;
+	}
+	else if(name == "nameOfSpikeFile")
+	{
+		nameOfSpikeFile = value;
+	}
+	else if(name == "nameOfRasterFile")
+	{
+		nameOfRasterFile = value;
+	}
+	else if(name == "sweepRatiosJinOverJexG")
+	{
+		sweepRatiosJinOverJexG = parseList(value, name);
+	}
+	else if(name == "sweepRatiosVextOverVthr")
+	{
+		sweepRatiosVextOverVthr = parseList(value, name);
+	}
+	else if(name == "nameOfSweepFile")
+	{
+		nameOfSweepFile = value;
+	}
+	else
+	{
+		throw invalid_argument("unknown parameter " + name);
+	}
+}
+
+void SimulationConfig::validate() const
+{
+	if(numberOfNeurons == 0)
+	{ throw invalid_argument("numberOfNeurons must be positive"); }
+	if(not (percentExcitatoryNeurons >= 0 and percentExcitatoryNeurons <= 100))
+	{ throw invalid_argument("percentExcitatoryNeurons must lie between 0 and 100"); }
+	if(not (ratioCOverNe >= 0 and ratioCOverNe <= 1))
+	{ throw invalid_argument("ratioCOverNe must lie between 0 and 1"); }
+	if(getNumberOfConnectionsFromExcitatoryNeurons() > 0 and getNumberOfExcitatoryNeurons() == 0)
+	{ throw invalid_argument("the network needs excitatory neurons to draw excitatory connections from"); }
+	if(getNumberOfConnectionsFromInhibitoryNeurons() > 0 and getNumberOfInhibitoryNeurons() == 0)
+	{ throw invalid_argument("the network needs inhibitory neurons to draw inhibitory connections from"); }
+	if(not (timeStepH > 0))
+	{ throw invalid_argument("timeStepH must be positive"); }
+	if(not (timeConstantTau > 0))	//division by zero when the membrane potential is updated
+	{ throw invalid_argument("timeConstantTau must be positive"); }
+	if(not (spikeAmplitudeJExcitatory > 0))	//the background noise is expressed in excitatory spikes
+	{ throw invalid_argument("spikeAmplitudeJExcitatory must be positive"); }
+	if(isEventDriven and not (membranePotentialThreshold > 0))	//a neuron that doesn't receive input would reach the threshold by decaying towards zero
+	{ throw invalid_argument("membranePotentialThreshold must be positive in the event-driven mode"); }
+	if(isCountingSpikes and max(getNumberOfConnectionsFromExcitatoryNeurons(), getNumberOfConnectionsFromInhibitoryNeurons()) > numeric_limits<uint16_t>::max())	//each presynaptic neuron spikes at most once in the step a slot stands for
+	{ throw invalid_argument("a neuron can't receive more than 65535 connections from a population when the spikes are counted"); }
+	if(not (ratioVextOverVthr >= 0))
+	{ throw invalid_argument("ratioVextOverVthr must not be negative"); }
+	if(timeBeginMeasurement >= finalTime)
+	{ throw invalid_argument("timeBeginMeasurement must precede finalTime"); }
+	if(not isSweep() and (timeBeginPrintToTxtFile > timeEndPrintToTxtFile or timeEndPrintToTxtFile > finalTime))	//a sweep doesn't print the spikes
+	{ throw invalid_argument("the printed interval must lie within the simulation"); }
+	if(spikeChannelCapacity == 0 or spikeChannelCapacity > (1u << 31))	//rounded up to a power of two
+	{ throw invalid_argument("spikeChannelCapacity must lie between 1 and 2^31"); }
+	if(sweepRatiosJinOverJexG.empty() != sweepRatiosVextOverVthr.empty())
+	{ throw invalid_argument("a parameter sweep needs values of both sweepRatiosJinOverJexG and sweepRatiosVextOverVthr"); }
+	for(double ratio: sweepRatiosVextOverVthr)
+	{
+		if(not (ratio >= 0))
+		{ throw invalid_argument("sweepRatiosVextOverVthr must not be negative"); }
+	}
+}
+
+bool SimulationConfig::isSweep() const
+{ return not sweepRatiosJinOverJexG.empty(); }
+
+unsigned int SimulationConfig::getNumberOfExcitatoryNeurons() const
+{ return numberOfNeurons*percentExcitatoryNeurons/100; }
+
+unsigned int SimulationConfig::getNumberOfInhibitoryNeurons() const
+{ return numberOfNeurons - getNumberOfExcitatoryNeurons(); }
+
+unsigned int SimulationConfig::getNumberOfConnectionsFromExcitatoryNeurons() const
+{ return getNumberOfExcitatoryNeurons()*ratioCOverNe; }
+
+unsigned int SimulationConfig::getNumberOfConnectionsFromInhibitoryNeurons() const
+{ return getNumberOfInhibitoryNeurons()*ratioCOverNe; }
+
+double SimulationConfig::getDecayOfMembranePotential() const
+{ return exp(-timeStepH/timeConstantTau); }
+
+double SimulationConfig::getMeanNumberOfExternalSpikes(double ratioVextOverVthr) const
+{ return ratioVextOverVthr*membranePotentialThreshold*timeStepH/(spikeAmplitudeJExcitatory*timeConstantTau); }	//V_EXT*J_EXT*h*Cext, see Neuron::getBackgroundNoise()
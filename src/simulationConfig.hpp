@@ -0,0 +1,96 @@
+#ifndef SIMULATION_CONFIG_H
+#define SIMULATION_CONFIG_H
+
+#include "parameters.hpp"
+
+#include <string>
+#include <vector>
+
+/** The parameters of a simulation, read at startup instead of being fixed at compile time.
+ * Each parameter takes the value of the corresponding constant of the parameter file by default and can be overridden by a configuration file or by the command line,
+   so that changing the size of the network, the signal delay or the duration of a simulation doesn't require rebuilding the program.
+   A configuration file contains one "name = value" pair per line, everything following a '#' is a comment. On the command line the same pairs are written "name=value",
+   "config=fileName" reads a configuration file, the pairs that follow it override the ones of the file.
+ * @see Network
+ * @see NeuronPopulation */
+struct SimulationConfig
+{
+	//network
+	unsigned int numberOfNeurons = TOTAL_NUMBER_OF_NEURONS_N; ///< The number of neurons in the network, N.
+	double percentExcitatoryNeurons = PERCENT_EXCITATORY_NEURONS; ///< The percentage of excitatory neurons, which come first in the network.
+	double ratioCOverNe = RATIO_C_OVER_N_E; ///< The ratio of the number of connections a neuron receives from a population and the size of that population, Ce/Ne = Ci/Ni.
+	unsigned int numberOfThreads = NUMBER_OF_THREADS_BY_DEFAULT; ///< The number of threads sharing the update, zero stands for as many as the hardware supports.
+	unsigned int seed = 0; ///< The seed of the background noise, zero stands for a random one.
+	unsigned int connectionSeed = CONNECTION_SEED_BY_DEFAULT; ///< The seed of the random connections, which don't depend on the number of threads drawing them.
+	bool isEventDriven = false; ///< If true, only the neurons that receive input in a step are updated, the others catch up on their decay when input reaches them. Pays off when few neurons receive input in a step, which the background noise usually prevents.
+	bool isCountingSpikes = false; ///< If true, the ring buffers count the excitatory and the inhibitory spikes in 16 bit integers, whose amplitudes are applied once when a slot is read. Needs a quarter of the memory of the ring buffers of doubles.
+
+	//neurons
+	double timeStepH = MIN_TIME_INTERVAL_H; ///< The duration of one step, in ms.
+	unsigned int signalDelayD = SIGNAL_DELAY_D; ///< The delay between the emission and the reception of a spike, in steps.
+	unsigned int refractionPeriod = REFRACTION_PERIOD; ///< The period following a spike during which a neuron is insensitive to stimulation, in steps.
+	double timeConstantTau = TIME_CONSTANT_TAU; ///< The membrane time constant, in ms.
+	double membranePotentialThreshold = MEMBRANE_POTENTIAL_THRESHOLD; ///< The membrane potential at which a neuron spikes, in mV.
+	double resetMembranePotential = RESET_MEMBRANE_POTENTIAL; ///< The membrane potential just after a spike, in mV.
+	double initialMembranePotential = INITIAL_MEMBRANE_POTENTIAL; ///< The membrane potential at the beginning of the simulation, in mV.
+	double spikeAmplitudeJExcitatory = SPIKE_AMPLITUDE_J_EXCITATORY_NEURON; ///< The spike amplitude of the excitatory neurons and of the background noise, in mV.
+	double ratioJinOverJexG = J_INHIBATORY_OVER_J_EXCITATORY_G; ///< The ratio of the spike amplitudes of the inhibitory and the excitatory neurons, g.
+	double ratioVextOverVthr = RATIO_V_EXTERNAL_OVER_V_THRESHOLD; ///< The frequency of the background noise over the one needed to reach the threshold in absence of feedback.
+
+	//simulation
+	unsigned int finalTime = FINAL_TIME; ///< The time at which the simulation ends, in steps.
+	unsigned int timeBeginMeasurement = TIME_BEGIN_MEASUREMENT_BY_DEFAULT; ///< The time from which on the mean spike rate is measured, once the network has settled, in steps.
+	unsigned int timeBeginPrintToTxtFile = TIME_BEGIN_PRINT_TO_TXT_FILE_BY_DEFAULT; ///< The beginning of the interval whose spikes are printed to the text file, in steps.
+	unsigned int timeEndPrintToTxtFile = TIME_END_PRINT_TO_TXT_FILE_BY_DEFAULT; ///< The end of the interval whose spikes are printed to the text file, in steps.
+	std::string nameOfFile = NAME_OF_FILE; ///< The name of the text file the spikes are printed to.
+	std::string nameOfSpikeFile = ""; ///< The name of the binary file the spikes are streamed to during the simulation, none if it is empty, see BinarySpikeRecorder.
+	std::string nameOfRasterFile = ""; ///< The name of the raster file the spikes are written to at the end of the simulation, none if it is empty, see SpikeRaster.
+	unsigned int spikeChannelCapacity = SPIKE_CHANNEL_CAPACITY_BY_DEFAULT; ///< The number of spikes waiting to be written to each file by its own thread, rounded up to a power of two, see AsynchronousSpikeRecorder.
+
+	//parameter sweep
+	std::vector<double> sweepRatiosJinOverJexG; ///< The values of g of a parameter sweep, written "3,4.5,6" or "first:last:step", no sweep if it is empty, see ParameterSweep.
+	std::vector<double> sweepRatiosVextOverVthr; ///< The values of Vext/Vthr of a parameter sweep, combined with each value of g.
+	std::string nameOfSweepFile = NAME_OF_SWEEP_FILE; ///< The name of the text file the table of a parameter sweep is written to.
+
+	/** Reads a configuration file, the parameters it doesn't mention keep their current value.
+	 * @throw std::invalid_argument if the file can't be read or contains an unknown name or an invalid value
+	 * @param nameOfConfigFile a string */
+	void readFile(const std::string& nameOfConfigFile);
+
+	/** Reads the "name=value" pairs of the command line, the parameters it doesn't mention keep their current value.
+	 * @throw std::invalid_argument if an argument isn't a pair or contains an unknown name or an invalid value
+	 * @param argc the number of arguments, the first one being the name of the program
+	 * @param argv the arguments */
+	void readCommandLine(int argc, const char* const argv[]);
+
+	/** Sets one parameter given by its name.
+	 * @throw std::invalid_argument if the name is unknown or the value invalid
+	 * @param name a string, the name of the data member
+	 * @param value a string */
+	void set(const std::string& name, const std::string& value);
+
+	/** Checks that the parameters describe a network that can be simulated.
+	 * @throw std::invalid_argument naming the first inconsistent parameter */
+	void validate() const;
+
+	/** Tells whether a parameter sweep has been asked for instead of one of Brunel's figures.
+	 * @return a bool */
+	bool isSweep() const;
+
+	//derived parameters
+	/// The number of excitatory neurons, Ne.
+	unsigned int getNumberOfExcitatoryNeurons() const;
+	/// The number of inhibitory neurons, Ni.
+	unsigned int getNumberOfInhibitoryNeurons() const;
+	/// The number of connections each neuron receives from excitatory neurons, Ce.
+	unsigned int getNumberOfConnectionsFromExcitatoryNeurons() const;
+	/// The number of connections each neuron receives from inhibitory neurons, Ci.
+	unsigned int getNumberOfConnectionsFromInhibitoryNeurons() const;
+	/// The factor by which the membrane potential decays during one step, exp(-h/tau).
+	double getDecayOfMembranePotential() const;
+	/** The mean number of spikes a neuron receives from the rest of the brain in one step, V_ext*Ce*h.
+	 * @param ratioVextOverVthr a double */
+	double getMeanNumberOfExternalSpikes(double ratioVextOverVthr) const;
+};
+
+#endif
@@ -0,0 +1,58 @@
+#include "spikeChannel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+using namespace std;
+
+constexpr size_t SpikeChannel::CACHE_LINE_SIZE;
+
+namespace
+{
+	/// The smallest power of two that is at least a number, and at least one.
+	size_t roundUpToPowerOfTwo(size_t number)
+	{
+		size_t powerOfTwo(1);
+		while(powerOfTwo < number)
+		{
+			powerOfTwo *= 2;
+		}
+		return powerOfTwo;
+	}
+}
+
+SpikeChannel::SpikeChannel(size_t capacity)
+:records(roundUpToPowerOfTwo(capacity))
+,mask(records.size() - 1)
+,writePosition(0)
+,readPosition(0)
+{}
+
+size_t SpikeChannel::getCapacity() const
+{ return records.size(); }
+
+size_t SpikeChannel::push(unsigned int time, const unsigned int* firstNeuronId, const unsigned int* lastNeuronId, size_t& occupancy)
+{
+	const size_t position(writePosition.load(memory_order_relaxed));	//only this thread writes it
+	const size_t numberOfSpikes(min<size_t>(lastNeuronId - firstNeuronId, records.size() - (position - readPosition.load(memory_order_acquire))));	//the records the consumer has popped are free
+	for(size_t i(0); i < numberOfSpikes; i++)
+	{
+		records[(position + i) & mask] = {time, firstNeuronId[i]};
+	}
+	writePosition.store(position + numberOfSpikes, memory_order_release);	//publishes the records
+	occupancy = position + numberOfSpikes - readPosition.load(memory_order_relaxed);
+	return numberOfSpikes;
+}
+
+size_t SpikeChannel::pop(SpikeRecord* poppedRecords, size_t maximalNumberOfRecords)
+{
+	const size_t position(readPosition.load(memory_order_relaxed));	//only this thread writes it
+	const size_t numberOfRecords(min(maximalNumberOfRecords, writePosition.load(memory_order_acquire) - position));
+	for(size_t i(0); i < numberOfRecords; i++)
+	{
+		poppedRecords[i] = records[(position + i) & mask];
+	}
+	readPosition.store(position + numberOfRecords, memory_order_release);	//hands the records back to the producer
+	return numberOfRecords;
+}
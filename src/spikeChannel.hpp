@@ -0,0 +1,55 @@
+#ifndef SPIKE_CHANNEL_H
+#define SPIKE_CHANNEL_H
+
+#include "spikeRecorder.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/** A lock-free queue of spikes between exactly one thread that pushes them and one thread that pops them, in the same order.
+ * The spikes are stored in a ring of a power of two records. Each side only writes its own position and reads the other one's,
+   so that neither ever waits for a lock: a push into a full channel and a pop from an empty one simply move fewer spikes.
+ * @see AsynchronousSpikeRecorder */
+class SpikeChannel
+{
+	public:
+
+	/** A constructor.
+	 * @param capacity the number of spikes the channel holds at least, a size_t, rounded up to a power of two */
+	explicit SpikeChannel(size_t capacity);
+
+	SpikeChannel(const SpikeChannel&) = delete;
+	SpikeChannel& operator=(const SpikeChannel&) = delete;
+
+	/// A getter for the number of spikes the channel holds when it is full.
+	size_t getCapacity() const;
+
+	/**Pushes as many neurons that spiked in one step as there is room for, only called by the producing thread.
+	 * @param time the step, an unsigned int
+	 * @param firstNeuronId a pointer to the id of the first spiking neuron
+	 * @param lastNeuronId a pointer past the id of the last spiking neuron
+	 * @param occupancy receives the number of spikes in the channel after the push, a size_t
+	 * @return the number of spikes pushed, the first ones of the range */
+	size_t push(unsigned int time, const unsigned int* firstNeuronId, const unsigned int* lastNeuronId, size_t& occupancy);
+
+	/**Pops the oldest spikes, only called by the consuming thread.
+	 * @param records the array receiving the spikes
+	 * @param maximalNumberOfRecords the size of the array, a size_t
+	 * @return the number of spikes popped, zero if the channel is empty */
+	size_t pop(SpikeRecord* records, size_t maximalNumberOfRecords);
+
+	private:
+
+	static constexpr size_t CACHE_LINE_SIZE = 64; ///< The positions are on cache lines of their own, so that a side writing its position doesn't evict the other one's.
+
+	std::vector<SpikeRecord> records; ///< The ring.
+	size_t mask; ///< The size of the ring minus one, which maps a position to its record.
+	char paddingBeforeWritePosition[CACHE_LINE_SIZE]; ///< Keeps the positions apart from the ring's attributes.
+	std::atomic<size_t> writePosition; ///< The number of spikes pushed so far, only written by the producer.
+	char paddingBeforeReadPosition[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)]; ///< Keeps the positions apart.
+	std::atomic<size_t> readPosition; ///< The number of spikes popped so far, only written by the consumer.
+	char paddingAfterReadPosition[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)]; ///< Keeps the read position apart from what follows the channel.
+};
+
+#endif
@@ -0,0 +1,137 @@
+#include "spikeRaster.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+constexpr uint32_t SpikeRaster::MAGIC_NUMBER;
+constexpr uint32_t SpikeRaster::VERSION;
+constexpr size_t SpikeRaster::HEADER_SIZE;
+
+void SpikeRaster::write(const string& nameOfFile, double timeStep, const vector<uint64_t>& firstSpikes, const vector<uint32_t>& spikeTimes)
+{
+	assert(not firstSpikes.empty() and firstSpikes.back() == spikeTimes.size());
+	ofstream out(nameOfFile, ios::binary | ios::trunc);
+	const uint32_t header[] = {MAGIC_NUMBER, VERSION, static_cast<uint32_t>(firstSpikes.size() - 1), 0};
+	const uint64_t numberOfSpikes(spikeTimes.size());
+	out.write(reinterpret_cast<const char*>(header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(&timeStep), sizeof(timeStep));
+	out.write(reinterpret_cast<const char*>(&numberOfSpikes), sizeof(numberOfSpikes));
+	static_assert(sizeof(header) + sizeof(double) + sizeof(uint64_t) == HEADER_SIZE, "the header has a fixed size");
+	out.write(reinterpret_cast<const char*>(firstSpikes.data()), firstSpikes.size()*sizeof(uint64_t));
+	out.write(reinterpret_cast<const char*>(spikeTimes.data()), spikeTimes.size()*sizeof(uint32_t));
+	if(out.fail())
+	{
+		throw runtime_error("impossible to write in file " + nameOfFile);
+	}
+}
+
+SpikeRaster::SpikeRaster(const string& nameOfFile)
+:mapping(MAP_FAILED)
+,sizeOfMapping(0)
+,numberOfNeurons(0)
+,timeStep(0)
+,firstSpikes(nullptr)
+,spikeTimes(nullptr)
+,numberOfSpikes(0)
+{
+	const int fileDescriptor(open(nameOfFile.c_str(), O_RDONLY));
+	struct stat status;
+	if(fileDescriptor >= 0 and fstat(fileDescriptor, &status) == 0 and static_cast<size_t>(status.st_size) >= HEADER_SIZE)
+	{
+		sizeOfMapping = status.st_size;
+		mapping = mmap(nullptr, sizeOfMapping, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+	}
+	if(fileDescriptor >= 0)
+	{
+		close(fileDescriptor);	//the mapping stays valid
+	}
+	if(mapping == MAP_FAILED)
+	{
+		throw runtime_error("impossible to map the raster file " + nameOfFile);
+	}
+	
+	const char* const bytes(static_cast<const char*>(mapping));
+	uint32_t header[4];
+	memcpy(header, bytes, sizeof(header));
+	memcpy(&timeStep, bytes + sizeof(header), sizeof(timeStep));
+	memcpy(&numberOfSpikes, bytes + sizeof(header) + sizeof(timeStep), sizeof(numberOfSpikes));
+	numberOfNeurons = header[2];
+	const uint64_t sizeOfIndex((numberOfNeurons + uint64_t(1))*sizeof(uint64_t));	//at most 2^35 bytes
+	const uint64_t maximalSize(numeric_limits<size_t>::max());
+	const bool isSizeRepresentable(sizeOfIndex <= maximalSize - HEADER_SIZE and numberOfSpikes <= (maximalSize - HEADER_SIZE - sizeOfIndex)/sizeof(uint32_t));	//a bogus header mustn't wrap the expected size around
+	if(header[0] != MAGIC_NUMBER or header[1] != VERSION or not isSizeRepresentable or sizeOfMapping != HEADER_SIZE + sizeOfIndex + numberOfSpikes*sizeof(uint32_t))
+	{
+		munmap(mapping, sizeOfMapping);
+		throw runtime_error(nameOfFile + " isn't a raster file of version " + to_string(VERSION));
+	}
+	firstSpikes = reinterpret_cast<const uint64_t*>(bytes + HEADER_SIZE);	//aligned, since the mapping starts on a page
+	spikeTimes = reinterpret_cast<const uint32_t*>(bytes + HEADER_SIZE + sizeOfIndex);
+	
+	bool isIndexValid(firstSpikes[0] == 0 and firstSpikes[numberOfNeurons] == numberOfSpikes);	//the spikes of each neuron are then within the file
+	for(unsigned int i(0); isIndexValid and i < numberOfNeurons; i++)
+	{
+		isIndexValid = firstSpikes[i] <= firstSpikes[i + 1];
+	}
+	if(not isIndexValid)
+	{
+		munmap(mapping, sizeOfMapping);
+		throw runtime_error("the index of the raster file " + nameOfFile + " doesn't match its spikes");
+	}
+}
+
+SpikeRaster::~SpikeRaster()
+{
+	munmap(mapping, sizeOfMapping);
+}
+
+unsigned int SpikeRaster::getNumberOfNeurons() const
+{ return numberOfNeurons; }
+
+double SpikeRaster::getTimeStep() const
+{ return timeStep; }
+
+uint64_t SpikeRaster::getNumberOfSpikes() const
+{ return numberOfSpikes; }
+
+const uint32_t* SpikeRaster::beginSpikeTimes(unsigned int neuronId) const
+{
+	assert(neuronId < numberOfNeurons);
+	return spikeTimes + firstSpikes[neuronId];
+}
+
+const uint32_t* SpikeRaster::endSpikeTimes(unsigned int neuronId) const
+{
+	assert(neuronId < numberOfNeurons);
+	return spikeTimes + firstSpikes[neuronId + 1];
+}
+
+size_t SpikeRaster::getNumberOfSpikesInInterval(unsigned int neuronId, unsigned int beginInterval, unsigned int endInterval) const
+{
+	const uint32_t* const begin(lower_bound(beginSpikeTimes(neuronId), endSpikeTimes(neuronId), beginInterval));
+	return upper_bound(begin, endSpikeTimes(neuronId), endInterval) - begin;
+}
+
+double SpikeRaster::getMeanSpikeRateInInterval(unsigned int beginInterval, unsigned int endInterval) const
+{
+	assert(endInterval >= beginInterval);
+	double meanFrequency(0);
+	for(unsigned int i(0); i < numberOfNeurons; i++)
+	{
+		meanFrequency += getNumberOfSpikesInInterval(i, beginInterval, endInterval);
+	}
+	return meanFrequency/(static_cast<size_t>(numberOfNeurons)*(endInterval-beginInterval)*timeStep*0.001);
+}
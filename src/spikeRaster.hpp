@@ -0,0 +1,86 @@
+#ifndef SPIKE_RASTER_H
+#define SPIKE_RASTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** A finished simulation's spikes stored neuron by neuron in a file that is mapped into memory, so that they can be queried again and again without simulating nor parsing anything.
+ * The file starts with a header of HEADER_SIZE bytes: the magic number, the version of the format, the number of neurons N, a word reserved for later use (zero), the duration of a step in ms as a double and the number of spikes as a 64 bit word.
+   The index follows, N+1 64 bit offsets giving the position of each neuron's first spike, the last one being the number of spikes.
+   Then come the spike times in steps, 32 bit words, those of each neuron in increasing order. All numbers are stored in the byte order of the machine.
+   The spikes of a neuron in an interval are found by bisection, directly in the mapped file.
+ * @see SpikeRasterRecorder */
+class SpikeRaster
+{
+	public:
+
+	static constexpr std::uint32_t MAGIC_NUMBER = 0x54535253; ///< "SRST" in little endian, identifies the raster files.
+	static constexpr std::uint32_t VERSION = 1; ///< The version of the file format.
+	static constexpr size_t HEADER_SIZE = 32; ///< The number of bytes preceding the index.
+
+	/** Writes a raster file.
+	 * @throw std::runtime_error if the file can't be written
+	 * @param nameOfFile a string
+	 * @param timeStep the duration of one step in ms, a double
+	 * @param firstSpikes for each neuron the position of its first spike in spikeTimes, with one more entry giving the number of spikes
+	 * @param spikeTimes the spike times of all neurons one after the other, those of each neuron in increasing order */
+	static void write(const std::string& nameOfFile, double timeStep, const std::vector<std::uint64_t>& firstSpikes, const std::vector<std::uint32_t>& spikeTimes);
+
+	/** A constructor.
+	 * Maps a raster file into memory.
+	 * @throw std::runtime_error if the file can't be mapped, isn't a raster file of a known version or its index doesn't lie within the spike times
+	 * @param nameOfFile a string */
+	explicit SpikeRaster(const std::string& nameOfFile);
+
+	/// A destructor which unmaps the file.
+	~SpikeRaster();
+
+	SpikeRaster(const SpikeRaster&) = delete;
+	SpikeRaster& operator=(const SpikeRaster&) = delete;
+
+	/// A getter for the number of neurons.
+	unsigned int getNumberOfNeurons() const;
+
+	/// A getter for the duration of one step in ms.
+	double getTimeStep() const;
+
+	/// A getter for the number of spikes of all neurons.
+	std::uint64_t getNumberOfSpikes() const;
+
+	/**A getter for the spike times of a neuron, in increasing order.
+	 * @param neuronId an unsigned int
+	 * @return a pointer to the first spike time in the mapped file */
+	const std::uint32_t* beginSpikeTimes(unsigned int neuronId) const;
+
+	/**A getter for the end of the spike times of a neuron.
+	 * @param neuronId an unsigned int
+	 * @return a pointer past the last spike time in the mapped file */
+	const std::uint32_t* endSpikeTimes(unsigned int neuronId) const;
+
+	/**Counts the spikes of a neuron within an interval, bounds included.
+	 * @param neuronId an unsigned int
+	 * @param beginInterval in steps, an unsigned int
+	 * @param endInterval in steps, an unsigned int
+	 * @return a size_t */
+	size_t getNumberOfSpikesInInterval(unsigned int neuronId, unsigned int beginInterval, unsigned int endInterval) const;
+
+	/**Calculates the mean spike rate of the neurons in an interval as Network::getMeanSpikeRateInInterval does.
+	 * @param beginInterval in steps, an unsigned int
+	 * @param endInterval in steps, an unsigned int
+	 * @return the rate in Hz, a double */
+	double getMeanSpikeRateInInterval(unsigned int beginInterval, unsigned int endInterval) const;
+
+	private:
+
+	void* mapping; ///< The beginning of the mapped file.
+	size_t sizeOfMapping; ///< The size of the file in bytes.
+	unsigned int numberOfNeurons; ///< The number of neurons.
+	double timeStep; ///< The duration of one step in ms.
+	const std::uint64_t* firstSpikes; ///< The index in the mapped file.
+	const std::uint32_t* spikeTimes; ///< The spike times in the mapped file.
+	std::uint64_t numberOfSpikes; ///< The number of spikes given by the header, which the index has been checked against.
+};
+
+#endif
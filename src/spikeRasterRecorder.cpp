@@ -0,0 +1,64 @@
+#include "spikeRaster.hpp"
+#include "spikeRasterRecorder.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+SpikeRasterRecorder::SpikeRasterRecorder(const string& nameOfFile, unsigned int numberOfNeurons, double timeStep)
+:nameOfFile(nameOfFile)
+,numberOfNeurons(numberOfNeurons)
+,timeStep(timeStep)
+,hasUnwrittenSpikes(true)	//an empty raster is written as well
+{}
+
+SpikeRasterRecorder::~SpikeRasterRecorder()
+{
+	if(not hasUnwrittenSpikes)	//flushed by its owner, who has seen any error of the last write
+	{
+		return;
+	}
+	try
+	{
+		flush();
+	}
+	catch(const runtime_error& error)	//a destructor mustn't throw, but the spikes are lost
+	{
+		cerr << "Error: " << error.what() << endl;
+	}
+}
+
+void SpikeRasterRecorder::record(unsigned int time, const unsigned int* firstNeuronId, const unsigned int* lastNeuronId)
+{
+	for(const unsigned int* neuronId(firstNeuronId); neuronId != lastNeuronId; ++neuronId)
+	{
+		assert(*neuronId < numberOfNeurons);
+		spikes.push_back({time, *neuronId});
+	}
+	hasUnwrittenSpikes = true;
+}
+
+void SpikeRasterRecorder::flush()
+{
+	vector<uint64_t> firstSpikes(numberOfNeurons + size_t(1), 0);	//counted first, like the connections, see Connectivity
+	for(const SpikeRecord& spike: spikes)
+	{
+		firstSpikes[spike.neuronId + 1] ++;
+	}
+	partial_sum(firstSpikes.begin(), firstSpikes.end(), firstSpikes.begin());
+	
+	vector<uint32_t> spikeTimes(spikes.size());
+	vector<uint64_t> nextSpikes(firstSpikes.begin(), firstSpikes.end() - 1);
+	for(const SpikeRecord& spike: spikes)	//recorded in increasing order of time, hence sorted for each neuron
+	{
+		spikeTimes[nextSpikes[spike.neuronId] ++] = spike.time;
+	}
+	hasUnwrittenSpikes = false;	//an error is thrown to the caller, the destructor doesn't try again
+	SpikeRaster::write(nameOfFile, timeStep, firstSpikes, spikeTimes);
+}
@@ -0,0 +1,45 @@
+#ifndef SPIKE_RASTER_RECORDER_H
+#define SPIKE_RASTER_RECORDER_H
+
+#include "spikeRecorder.hpp"
+
+#include <string>
+#include <vector>
+
+/** A recorder that gathers the spikes of its window and writes them to a raster file, sorted neuron by neuron, when it is flushed or destroyed.
+ * Unlike the other recorders it keeps the spikes in memory until then, eight bytes per spike of the window.
+ * @see SpikeRaster
+ * @see Network::addSpikeRecorder */
+class SpikeRasterRecorder : public SpikeRecorder
+{
+	public:
+
+	/** A constructor.
+	 * @param nameOfFile the name of the raster file, a string
+	 * @param numberOfNeurons the size of the recorded network, an unsigned int
+	 * @param timeStep the duration of one step in ms, a double */
+	SpikeRasterRecorder(const std::string& nameOfFile, unsigned int numberOfNeurons, double timeStep);
+
+	/// A destructor which writes the raster file unless it is up to date, printing an error to std::cerr if it can't be written.
+	~SpikeRasterRecorder() override;
+
+	/**Gathers the neurons that spiked in one step.
+	 * @param time the step, an unsigned int
+	 * @param firstNeuronId a pointer to the id of the first spiking neuron
+	 * @param lastNeuronId a pointer past the id of the last spiking neuron */
+	void record(unsigned int time, const unsigned int* firstNeuronId, const unsigned int* lastNeuronId) override;
+
+	/**Writes the raster file of all the spikes gathered so far, overwriting the previous one.
+	 * @throw std::runtime_error if the file can't be written */
+	void flush() override;
+
+	private:
+
+	std::string nameOfFile; ///< The name of the raster file.
+	unsigned int numberOfNeurons; ///< The size of the recorded network.
+	double timeStep; ///< The duration of one step in ms.
+	std::vector<SpikeRecord> spikes; ///< The spikes gathered so far, in the order of recording.
+	bool hasUnwrittenSpikes; ///< True if the raster file doesn't contain all the spikes gathered so far.
+};
+
+#endif
@@ -0,0 +1,7 @@
+#include "spikeRecorder.hpp"
+
+SpikeRecorder::~SpikeRecorder()
+{}
+
+void SpikeRecorder::flush()
+{}
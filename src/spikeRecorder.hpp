@@ -0,0 +1,35 @@
+#ifndef SPIKE_RECORDER_H
+#define SPIKE_RECORDER_H
+
+#include <cstdint>
+
+/** A spike as it is written to and read from a file: the step in which it occurred and the id of the spiking neuron.
+ * @see BinarySpikeRecorder
+ * @see BinarySpikeReader */
+struct SpikeRecord
+{
+	std::uint32_t time; ///< The step in which the neuron spiked.
+	std::uint32_t neuronId; ///< The id of the spiking neuron.
+};
+
+/** The interface of the objects that receive the spikes of a network while it is being simulated, for instance to write them to a file.
+ * The network hands the spikes of each round over once they have been delivered, step after step and, within a step, in the order of the neurons' ids.
+ * @see Network::addSpikeRecorder */
+class SpikeRecorder
+{
+	public:
+
+	/// A destructor.
+	virtual ~SpikeRecorder();	//has to be virtual, since the recorders are used through pointers to the base class
+
+	/**Receives the neurons that spiked in one step.
+	 * @param time the step, an unsigned int
+	 * @param firstNeuronId a pointer to the id of the first spiking neuron
+	 * @param lastNeuronId a pointer past the id of the last spiking neuron */
+	virtual void record(unsigned int time, const unsigned int* firstNeuronId, const unsigned int* lastNeuronId) = 0;
+
+	/// Makes sure that the spikes recorded so far are stored, by default there is nothing to do.
+	virtual void flush();
+};
+
+#endif
@@ -0,0 +1,94 @@
+#include "spikeStatisticsRecorder.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+SpikeStatisticsRecorder::SpikeStatisticsRecorder(size_t numberOfNeurons, double timeStep)
+:timeStep(timeStep)
+,numberOfSpikesOfNeurons(numberOfNeurons, 0)
+,numberOfSpikesOfSteps()
+,timeOfLastStep(0)
+{}
+
+void SpikeStatisticsRecorder::record(unsigned int time, const unsigned int* firstNeuronId, const unsigned int* lastNeuronId)
+{
+	if(numberOfSpikesOfSteps.empty() or time != timeOfLastStep)
+	{
+		numberOfSpikesOfSteps.push_back(0);
+		timeOfLastStep = time;
+	}
+	numberOfSpikesOfSteps.back() += lastNeuronId - firstNeuronId;
+	for(const unsigned int* neuronId(firstNeuronId); neuronId != lastNeuronId; ++neuronId)
+	{
+		assert(*neuronId < numberOfSpikesOfNeurons.size());
+		numberOfSpikesOfNeurons[*neuronId]++;
+	}
+}
+
+size_t SpikeStatisticsRecorder::getNumberOfSteps() const
+{ return numberOfSpikesOfSteps.size(); }
+
+double SpikeStatisticsRecorder::getMeanSpikeRate(size_t firstNeuron, size_t lastNeuron) const
+{
+	assert(firstNeuron <= lastNeuron and lastNeuron <= numberOfSpikesOfNeurons.size());
+	if(firstNeuron == lastNeuron or numberOfSpikesOfSteps.empty())
+	{
+		return 0;
+	}
+	double numberOfSpikes(0);
+	for(size_t i(firstNeuron); i < lastNeuron; i++)
+	{
+		numberOfSpikes += numberOfSpikesOfNeurons[i];
+	}
+	return numberOfSpikes/((lastNeuron - firstNeuron)*numberOfSpikesOfSteps.size()*timeStep*0.001);	//the steps actually recorded, a window may extend beyond the end of the simulation
+}
+
+double SpikeStatisticsRecorder::getMeanSpikeRate() const
+{ return getMeanSpikeRate(0, numberOfSpikesOfNeurons.size()); }
+
+double SpikeStatisticsRecorder::getStandardDeviationOfSpikeRates() const
+{
+	if(numberOfSpikesOfSteps.empty())
+	{
+		return 0;
+	}
+	const double meanSpikeRate(getMeanSpikeRate());
+	const double durationInSeconds(numberOfSpikesOfSteps.size()*timeStep*0.001);
+	double sumOfSquares(0);
+	for(unsigned int numberOfSpikes: numberOfSpikesOfNeurons)
+	{
+		const double deviation(numberOfSpikes/durationInSeconds - meanSpikeRate);
+		sumOfSquares += deviation*deviation;
+	}
+	return sqrt(sumOfSquares/numberOfSpikesOfNeurons.size());
+}
+
+double SpikeStatisticsRecorder::getFractionOfSilentNeurons() const
+{
+	size_t numberOfSilentNeurons(0);
+	for(unsigned int numberOfSpikes: numberOfSpikesOfNeurons)
+	{
+		numberOfSilentNeurons += (numberOfSpikes == 0);
+	}
+	return static_cast<double>(numberOfSilentNeurons)/numberOfSpikesOfNeurons.size();
+}
+
+double SpikeStatisticsRecorder::getCoefficientOfVariationOfActivity() const
+{
+	double sum(0), sumOfSquares(0);
+	for(unsigned int numberOfSpikes: numberOfSpikesOfSteps)
+	{
+		sum += numberOfSpikes;
+		sumOfSquares += static_cast<double>(numberOfSpikes)*numberOfSpikes;
+	}
+	if(sum == 0)
+	{
+		return 0;
+	}
+	const double mean(sum/numberOfSpikesOfSteps.size());
+	return sqrt(max(sumOfSquares/numberOfSpikesOfSteps.size() - mean*mean, 0.0))/mean;
+}
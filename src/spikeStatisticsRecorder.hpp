@@ -0,0 +1,60 @@
+#ifndef SPIKE_STATISTICS_RECORDER_H
+#define SPIKE_STATISTICS_RECORDER_H
+
+#include "spikeRecorder.hpp"
+
+#include <cstddef>
+#include <vector>
+
+/** A recorder that keeps no spike but the number of spikes of each neuron and of each step, enough to summarize the state of the network without storing its activity.
+ * @see Network::addSpikeRecorder
+ * @see ParameterSweep */
+class SpikeStatisticsRecorder : public SpikeRecorder
+{
+	public:
+
+	/** A constructor.
+	 * @param numberOfNeurons the size of the network, a size_t
+	 * @param timeStep the duration of one step in ms, a double */
+	SpikeStatisticsRecorder(size_t numberOfNeurons, double timeStep);
+
+	/**Counts the neurons that spiked in one step.
+	 * @param time the step, an unsigned int
+	 * @param firstNeuronId a pointer to the id of the first spiking neuron
+	 * @param lastNeuronId a pointer past the id of the last spiking neuron */
+	void record(unsigned int time, const unsigned int* firstNeuronId, const unsigned int* lastNeuronId) override;
+
+	/// A getter for the number of steps recorded so far.
+	size_t getNumberOfSteps() const;
+
+	/** The mean spike rate of a range of neurons over the recorded steps.
+	 * @param firstNeuron the id of the first neuron, a size_t
+	 * @param lastNeuron the id past the last neuron, a size_t
+	 * @return the spike rate in Hz, a double, zero if nothing has been recorded */
+	double getMeanSpikeRate(size_t firstNeuron, size_t lastNeuron) const;
+
+	/** The mean spike rate of all the neurons over the recorded steps.
+	 * @return the spike rate in Hz, a double */
+	double getMeanSpikeRate() const;
+
+	/** How much the spike rates of the neurons differ from one another.
+	 * @return the standard deviation of the neurons' spike rates in Hz, a double */
+	double getStandardDeviationOfSpikeRates() const;
+
+	/** The share of the neurons that didn't spike at all in the recorded steps.
+	 * @return a double between 0 and 1 */
+	double getFractionOfSilentNeurons() const;
+
+	/** How much the number of spikes varies from one step to the next, low in the asynchronous states and high in the synchronous ones of Brunel's phase diagram.
+	 * @return the standard deviation of the number of spikes per step divided by its mean, a double, zero if there was no spike */
+	double getCoefficientOfVariationOfActivity() const;
+
+	private:
+
+	double timeStep; ///< The duration of one step in ms.
+	std::vector<unsigned int> numberOfSpikesOfNeurons; ///< The number of spikes of each neuron.
+	std::vector<unsigned int> numberOfSpikesOfSteps; ///< The number of spikes of each recorded step.
+	unsigned int timeOfLastStep; ///< The latest step recorded, the network may hand a step over in several parts.
+};
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef STATE_REPRESENTATION_H
+#define STATE_REPRESENTATION_H
+
+#include <cmath>
+#include <cstdint>
+
+typedef std::int32_t FixedPointState; ///< The state type of a population whose membrane potentials and inputs are integer multiples of a fraction of the excitatory spike amplitude, see StateRepresentation<FixedPointState>.
+
+/** How the membrane potentials and the inputs of a population are stored, in millivolts as floating point numbers of the given type.
+ * double is the reference, float halves the memory traffic and doubles the number of neurons per vector instruction, its 24 bit mantissa resolving 20 mV to about 1 nV.
+ * @see BasicNeuronPopulation
+ * @tparam State float or double */
+template<typename State>
+class StateRepresentation
+{
+	public:
+
+	typedef State Factor; ///< The type of the factors the membrane potentials are multiplied by, such as the decay.
+
+	/** A constructor.
+	 * @param unit the excitatory spike amplitude in mV, ignored by the floating point representations */
+	explicit StateRepresentation(double)
+	{}
+
+	/** Converts a potential.
+	 * @param potential in mV, a double
+	 * @return the potential as stored */
+	State fromMillivolts(double potential) const
+	{ return static_cast<State>(potential); }
+
+	/** Converts a stored potential back.
+	 * @param state a potential as stored
+	 * @return the potential in mV, a double */
+	double toMillivolts(State state) const
+	{ return state; }
+
+	/** Converts a factor, such as the decay of the membrane potential.
+	 * @param factor a double
+	 * @return the factor as stored */
+	static Factor toFactor(double factor)
+	{ return static_cast<Factor>(factor); }
+
+	/** Multiplies a stored potential by a factor.
+	 * @param state a potential as stored
+	 * @param factor a factor as stored
+	 * @return the product as stored */
+	static State multiply(State state, Factor factor)
+	{ return state*factor; }
+};
+
+/** The fixed point representation of the membrane potentials and the inputs, in multiples of the excitatory spike amplitude J divided by 2^16.
+ * J and the inhibitory amplitude gJ, for a g with at most 16 binary digits after the point, are exact, so the ring buffers sum the spikes without any rounding,
+   and the threshold of 200 J of the parameter file leaves room for potentials up to 32768 J, which the input of a neuron, at most (C_E + g*C_I)*J in a step, mustn't exceed, see BasicNetwork. Only the decay, a 31 bit fraction, rounds the potential to the nearest multiple once per step.
+ * @see BasicNeuronPopulation */
+template<>
+class StateRepresentation<FixedPointState>
+{
+	public:
+
+	typedef std::int64_t Factor; ///< A fraction of 2^31, the products of a potential and a factor fit into 63 bits.
+
+	static constexpr double QUANTA_PER_UNIT = 65536; ///< The number of steps of the representation per excitatory spike amplitude.
+	static constexpr int FRACTION_BITS_OF_FACTORS = 31; ///< The number of bits after the point of the factors.
+
+	/** A constructor.
+	 * @param unit the excitatory spike amplitude in mV, a positive double */
+	explicit StateRepresentation(double unit)
+	:quantaPerMillivolt(QUANTA_PER_UNIT/((unit > 0) ? unit : 1))
+	{}
+
+	/** Converts a potential, rounded to the nearest multiple of the representation's step.
+	 * @param potential in mV, a double
+	 * @return the potential as stored */
+	FixedPointState fromMillivolts(double potential) const
+	{ return static_cast<FixedPointState>(std::lround(potential*quantaPerMillivolt)); }
+
+	/** Converts a stored potential back.
+	 * @param state a potential as stored
+	 * @return the potential in mV, a double */
+	double toMillivolts(FixedPointState state) const
+	{ return state/quantaPerMillivolt; }
+
+	/** Converts a factor between 0 and 1, such as the decay of the membrane potential.
+	 * @param factor a double
+	 * @return the factor as stored */
+	static Factor toFactor(double factor)
+	{ return std::llround(std::ldexp(factor, FRACTION_BITS_OF_FACTORS)); }
+
+	/** Multiplies a stored potential by a factor, rounding half up to the nearest multiple of the representation's step.
+	 * @param state a potential as stored
+	 * @param factor a factor as stored
+	 * @return the product as stored */
+	static FixedPointState multiply(FixedPointState state, Factor factor)
+	{ return static_cast<FixedPointState>((state*factor + (Factor(1) << (FRACTION_BITS_OF_FACTORS - 1))) >> FRACTION_BITS_OF_FACTORS); }
+
+	private:
+
+	double quantaPerMillivolt; ///< The number of steps of the representation per mV.
+};
+
+#endif
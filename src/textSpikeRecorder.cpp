@@ -0,0 +1,30 @@
+#include "textSpikeRecorder.hpp"
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+TextSpikeRecorder::TextSpikeRecorder(const string& nameOfFile, double timeStep)
+:out(nameOfFile)
+,timeStep(timeStep)
+{
+	if(out.fail())
+	{
+		throw runtime_error("impossible to write in file " + nameOfFile);
+	}
+}
+
+void TextSpikeRecorder::record(unsigned int time, const unsigned int* firstNeuronId, const unsigned int* lastNeuronId)
+{
+	for(const unsigned int* neuronId(firstNeuronId); neuronId != lastNeuronId; ++neuronId)
+	{
+		out << time*timeStep << '\t' << *neuronId << '\n';	//prints the times, not in number of steps, but converted milliseconds
+	}
+}
+
+void TextSpikeRecorder::flush()
+{
+	out.flush();
+}
@@ -0,0 +1,39 @@
+#ifndef TEXT_SPIKE_RECORDER_H
+#define TEXT_SPIKE_RECORDER_H
+
+#include "spikeRecorder.hpp"
+
+#include <fstream>
+#include <string>
+
+/** A recorder that prints the spikes to a text file while the network is being simulated, one line per spike giving its time in ms and the id of the neuron, separated by a tab.
+ * This is the format pyscript.py reads to draw Brunel's figures.
+ * @see Network::addSpikeRecorder
+ * @see Simulation::printDataForBrunelFigureToFile */
+class TextSpikeRecorder : public SpikeRecorder
+{
+	public:
+
+	/** A constructor.
+	 * Creates the file, overwriting an existing one.
+	 * @throw std::runtime_error if the file can't be written
+	 * @param nameOfFile a string
+	 * @param timeStep the duration of one step in ms, a double */
+	TextSpikeRecorder(const std::string& nameOfFile, double timeStep);
+
+	/**Prints the neurons that spiked in one step.
+	 * @param time the step, an unsigned int
+	 * @param firstNeuronId a pointer to the id of the first spiking neuron
+	 * @param lastNeuronId a pointer past the id of the last spiking neuron */
+	void record(unsigned int time, const unsigned int* firstNeuronId, const unsigned int* lastNeuronId) override;
+
+	/// Flushes the file.
+	void flush() override;
+
+	private:
+
+	std::ofstream out; ///< The file.
+	double timeStep; ///< The duration of one step in ms.
+};
+
+#endif
@@ -0,0 +1,168 @@
+#include "workerPool.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+	/// Packs the first task and the end of a range of tasks into one word.
+	uint64_t packRange(uint64_t firstTask, uint64_t endTask)
+	{ return firstTask | (endTask << 32); }
+	
+	/// The index of the next task of a range.
+	size_t getFirstTask(uint64_t range)
+	{ return range & 0xffffffffu; }
+	
+	/// The index past the last task of a range.
+	size_t getEndTask(uint64_t range)
+	{ return range >> 32; }
+}
+
+WorkerPool::WorkerPool(size_t numberOfWorkers)
+:currentTask(nullptr)
+,numberOfTasksStarted(0)
+,numberOfBusyThreads(0)
+,isStopping(false)
+,taskRanges(new TaskRange[numberOfWorkers])
+{
+	assert(numberOfWorkers > 0);
+	for(size_t workerId(1); workerId < numberOfWorkers; workerId++)
+	{
+		threads.push_back(thread(&WorkerPool::work, this, workerId));
+	}
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		lock_guard<mutex> lock(stateMutex);
+		isStopping = true;
+	}
+	taskAvailable.notify_all();
+	for(auto& worker: threads)
+	{
+		worker.join();
+	}
+}
+
+size_t WorkerPool::size() const
+{ return threads.size() + 1; }
+
+void WorkerPool::run(const function<void(size_t)>& task)
+{
+	if(threads.empty())	//nothing to synchronize
+	{
+		task(0);
+		return;
+	}
+
+	{
+		lock_guard<mutex> lock(stateMutex);
+		currentTask = &task;
+		numberOfBusyThreads = threads.size();
+		numberOfTasksStarted ++;
+	}
+	taskAvailable.notify_all();
+
+	task(0);	//the calling thread is worker 0
+
+	unique_lock<mutex> lock(stateMutex);
+	taskFinished.wait(lock, [this]{ return numberOfBusyThreads == 0; });
+	currentTask = nullptr;
+}
+
+void WorkerPool::runTasks(size_t numberOfTasks, const function<void(size_t, size_t)>& task)
+{
+	assert(numberOfTasks < (uint64_t(1) << 32));
+	if(threads.empty())
+	{
+		for(size_t taskId(0); taskId < numberOfTasks; taskId++)
+		{
+			task(0, taskId);
+		}
+		return;
+	}
+	
+	for(size_t workerId(0); workerId < size(); workerId++)
+	{
+		taskRanges[workerId].range.store(packRange(workerId*numberOfTasks/size(), (workerId + 1)*numberOfTasks/size()), memory_order_relaxed);
+	}
+	run([this, &task](size_t workerId)	//run() publishes the ranges to the threads through its mutex
+	{
+		size_t taskId(0);
+		while(popTask(workerId, taskId) or (stealTasks(workerId) and popTask(workerId, taskId)))
+		{
+			task(workerId, taskId);
+		}
+	});
+}
+
+bool WorkerPool::popTask(size_t workerId, size_t& task)
+{
+	atomic<uint64_t>& ownRange(taskRanges[workerId].range);
+	uint64_t range(ownRange.load(memory_order_acquire));
+	while(getFirstTask(range) < getEndTask(range))
+	{
+		if(ownRange.compare_exchange_weak(range, packRange(getFirstTask(range) + 1, getEndTask(range)), memory_order_acq_rel))	//a thief may have shortened the range in the meantime
+		{
+			task = getFirstTask(range);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool WorkerPool::stealTasks(size_t workerId)
+{
+	for(size_t i(1); i < size(); i++)	//the victims are visited in the same order by each thief
+	{
+		atomic<uint64_t>& victimRange(taskRanges[(workerId + i)%size()].range);
+		uint64_t range(victimRange.load(memory_order_acquire));
+		while(getFirstTask(range) < getEndTask(range))
+		{
+			const size_t firstStolenTask(getEndTask(range) - (getEndTask(range) - getFirstTask(range) + 1)/2);	//the second half, at least one task
+			if(victimRange.compare_exchange_weak(range, packRange(getFirstTask(range), firstStolenTask), memory_order_acq_rel))
+			{
+				taskRanges[workerId].range.store(packRange(firstStolenTask, getEndTask(range)), memory_order_release);	//the own range was empty, no other thread changes it
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void WorkerPool::work(size_t workerId)
+{
+	unsigned long numberOfTasksDone(0);
+	while(true)
+	{
+		const function<void(size_t)>* task(nullptr);
+		{
+			unique_lock<mutex> lock(stateMutex);
+			taskAvailable.wait(lock, [this, numberOfTasksDone]{ return isStopping or numberOfTasksStarted != numberOfTasksDone; });
+			if(isStopping)
+			{
+				return;
+			}
+			task = currentTask;
+			numberOfTasksDone = numberOfTasksStarted;
+		}
+
+		(*task)(workerId);
+
+		lock_guard<mutex> lock(stateMutex);
+		if(--numberOfBusyThreads == 0)
+		{
+			taskFinished.notify_one();
+		}
+	}
+}
@@ -0,0 +1,82 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** A fixed number of threads that run the same task together.
+ * The threads are created once and wait between two tasks, which is much cheaper than creating new threads at each step of the simulation.
+   The thread calling run() takes part in the work as worker 0.
+ * The threads can also share a number of smaller tasks whose durations differ, see runTasks(), by stealing the tasks of the others once they are done with their own.
+ * @see Network::update() */
+class WorkerPool
+{
+	public:
+
+	/** A constructor.
+	 * Starts numberOfWorkers-1 threads, the calling thread being the remaining worker.
+	 * @param numberOfWorkers a size_t, at least one */
+	explicit WorkerPool(size_t numberOfWorkers);
+
+	/// A destructor which stops and joins the threads.
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	/// A getter for the number of workers, the calling thread included.
+	size_t size() const;
+
+	/**Runs a task on all workers and returns once all of them are done.
+	 * @param task a function that receives the id of the worker executing it, from 0 to size()-1 */
+	void run(const std::function<void(size_t)>& task);
+
+	/**Runs a number of tasks on all workers and returns once all of them are done.
+	 * Each worker first gets an equal share of consecutive tasks, which it runs in increasing order. A worker that is done with its share steals
+	   the second half of the remaining tasks of another worker, so that all workers stay busy until the last tasks even if some tasks take much longer than others.
+	 * @param numberOfTasks a size_t, less than 2^32
+	 * @param task a function that receives the id of the worker executing it and the index of the task, from 0 to numberOfTasks-1 */
+	void runTasks(size_t numberOfTasks, const std::function<void(size_t, size_t)>& task);
+
+	private:
+
+	std::vector<std::thread> threads; ///< The workers 1 to size()-1.
+	std::mutex stateMutex; ///< Protects the attributes below.
+	std::condition_variable taskAvailable; ///< Wakes up the threads when a task is started or when the pool is destroyed.
+	std::condition_variable taskFinished; ///< Wakes up the caller of run() when the last thread is done.
+	const std::function<void(size_t)>* currentTask; ///< The task being run, a pointer to the argument of run().
+	unsigned long numberOfTasksStarted; ///< Tells the threads that a new task is available.
+	size_t numberOfBusyThreads; ///< The number of threads that haven't finished the current task yet.
+	bool isStopping; ///< True once the pool is being destroyed.
+
+	/// The tasks a worker still has to run, on a cache line of their own since the other workers read them when they look for tasks to steal.
+	struct TaskRange
+	{
+		std::atomic<std::uint64_t> range; ///< The index of the next task in the low 32 bits and the index past the last task in the high 32 bits, changed at once by compare and swap.
+		char padding[64 - sizeof(std::atomic<std::uint64_t>)]; ///< Fills the cache line.
+	};
+	std::unique_ptr<TaskRange[]> taskRanges; ///< The tasks left to each worker during runTasks().
+
+	/**The loop of a thread, waiting for tasks and running them.
+	 * @param workerId a size_t */
+	void work(size_t workerId);
+
+	/**Takes the next task of a worker's own range.
+	 * @param workerId a size_t
+	 * @param task receives the index of the task
+	 * @return false if the worker's range is empty */
+	bool popTask(size_t workerId, size_t& task);
+
+	/**Moves the second half of the tasks of another worker, the first one that has any, to the empty range of a worker.
+	 * @param workerId a size_t
+	 * @return false if no worker has tasks left */
+	bool stealTasks(size_t workerId);
+};
+
+#endif